@@ -27,6 +27,11 @@ void logMessages() {
 	logger.info("This is a formatted info message: %d", 42);
 	logger.debug("This is a formatted debug message: %s", text);
 	logger.trace("This is a formatted TRACE message: %d", counter);
+#ifdef JBLOGGER_HAS_JBFMT
+	logger.info(JBFMT("This is a compile-time checked info message: %d, %s"), counter, text);
+#endif
+	JBLOG_DEBUG(logger, "This is a debug message that can be switched on and off: %d", counter);
+	logger.info() << "This is an info message built from parts: " << counter << ", " << stdString;
 	logger.trace("traceDump:");
 	logger.traceDump(buffer, strlen(buffer));
 	logger.trace("traceHexDump:");
@@ -0,0 +1,98 @@
+/// @file Arduino.cpp
+/// @author Jonny Bergdahl
+/// @brief Minimal Arduino API for building JBLogger on a desktop host
+/// @date Created: 2026-10-18
+/// @details This file contains the code for the host Arduino API: the clock, the interrupt
+/// lock, Print number formatting, Serial and IPAddress printing.
+///
+/// You can find the source code and/ collaborate on
+/// [https://github.com/jonnybergdahl/Bergdahl_JBLogger](https://github.com/jonnybergdahl/Bergdahl_JBLogger).
+///
+/// This code is distributed under the MIT License. See the LICENSE file for details.
+#include "Arduino.h"
+#include <chrono>
+#include <mutex>
+
+HostSerial Serial;
+
+static bool simulatedClock = false;					///< True if the clock only moves on delay() and Serial
+static unsigned long long clockOffset = 0;			///< Time added by delay() and Serial, in us
+
+/// @brief Returns the time in us since the program started
+static unsigned long long now() {
+	if (simulatedClock) {
+		return clockOffset;
+	}
+	using namespace std::chrono;
+	static const steady_clock::time_point start = steady_clock::now();
+	return static_cast<unsigned long long>(duration_cast<microseconds>(steady_clock::now() - start).count()) + clockOffset;
+}
+
+unsigned long millis() {
+	return static_cast<unsigned long>(now() / 1000);
+}
+
+unsigned long micros() {
+	return static_cast<unsigned long>(now());
+}
+
+void delay(unsigned long ms) {
+	clockOffset += ms * 1000ULL;
+}
+
+static std::mutex interruptLock;						///< Held between noInterrupts() and interrupts()
+
+void noInterrupts() {
+	interruptLock.lock();
+}
+
+void interrupts() {
+	interruptLock.unlock();
+}
+
+void host::setSimulatedClock(bool value) {
+	simulatedClock = value;
+}
+
+size_t Print::print(long value, int base) {
+	char text[24];
+	snprintf(text, sizeof(text), base == HEX ? "%lX" : "%ld", value);
+	return write(text);
+}
+
+size_t Print::print(unsigned long value, int base) {
+	char text[24];
+	snprintf(text, sizeof(text), base == HEX ? "%lX" : "%lu", value);
+	return write(text);
+}
+
+size_t Print::print(double value, int digits) {
+	char text[48];
+	snprintf(text, sizeof(text), "%.*f", digits, value);
+	return write(text);
+}
+
+void HostSerial::begin(unsigned long baud) {
+	// 10 bits per byte, start and stop bit included
+	_byteMicros = baud > 0 ? 10000000UL / baud : 0;
+}
+
+size_t HostSerial::write(uint8_t value) {
+	return write(&value, 1);
+}
+
+size_t HostSerial::write(const uint8_t *buffer, size_t size) {
+	clockOffset += _byteMicros * size;
+	return fwrite(buffer, 1, size, stdout);
+}
+
+size_t IPAddress::printTo(Print &output) const {
+	size_t count = 0;
+	for (int i = 0; i < 4; i++) {
+		if (i > 0) {
+			count += output.print('.');
+		}
+		count += output.print(static_cast<unsigned int>(_bytes[i]), DEC);
+	}
+	return count;
+}
@@ -0,0 +1,191 @@
+/// @file Arduino.h
+/// @author Jonny Bergdahl
+/// @brief Minimal Arduino API for building JBLogger on a desktop host
+/// @date Created: 2026-10-18
+/// @details This file contains the small part of the Arduino API that the library uses, so
+/// the host checks and benchmarks in extras/tools can be built with a desktop compiler:
+///
+/// c++ -std=c++14 -O2 -I extras/host -I src ... extras/host/Arduino.cpp src/jblogger.cpp
+///
+/// It is not a full Arduino core. Serial writes to stdout and counts the time a 115200 baud
+/// UART would need, delay() only moves the clock forward, and String is a thin wrapper of
+/// std::string.
+///
+/// You can find the source code and/ collaborate on
+/// [https://github.com/jonnybergdahl/Bergdahl_JBLogger](https://github.com/jonnybergdahl/Bergdahl_JBLogger).
+///
+/// This code is distributed under the MIT License. See the LICENSE file for details.
+#ifndef JBLOGGER_HOST_ARDUINO_H
+#define JBLOGGER_HOST_ARDUINO_H
+
+#ifndef ARDUINO
+#define ARDUINO 10800				///< Arduino API version
+#endif
+
+#include <ctype.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+#define DEC 10						///< Decimal base for Print::print()
+#define HEX 16						///< Hex base for Print::print()
+
+#define PROGMEM						///< Flash storage, the host has none
+typedef const char *PGM_P;			///< Pointer to a string in flash
+#define pgm_read_byte(address) (*reinterpret_cast<const uint8_t *>(address))
+#define vsnprintf_P vsnprintf
+#define strlen_P strlen
+#define memcpy_P memcpy
+
+/// @brief Marks a string stored in flash, only used as a pointer type
+class __FlashStringHelper;
+#define F(text) (reinterpret_cast<const __FlashStringHelper *>(text))
+
+/// @brief Returns the time in ms since the program started
+unsigned long millis();
+
+/// @brief Returns the time in us since the program started
+unsigned long micros();
+
+/// @brief Moves the clock forward, without sleeping
+/// @param ms Time in ms
+void delay(unsigned long ms);
+
+/// @brief Stands in for disabling interrupts, takes a global lock so host threads are serialized
+void noInterrupts();
+
+/// @brief Stands in for enabling interrupts, releases the global lock
+void interrupts();
+
+/// @brief Host clock control, for benchmarks and checks
+namespace host {
+/// @brief Uses a simulated clock, only moved by delay() and Serial output, or the real clock
+/// @param value True for the simulated clock, the default is the real clock
+void setSimulatedClock(bool value);
+}
+
+/// @brief Arduino String, backed by std::string
+class String {
+public:
+	String(const char *text = "") : _text(text != nullptr ? text : "") {}
+	String(const std::string &text) : _text(text) {}
+	String(char value) : _text(1, value) {}
+	String(int value) : _text(std::to_string(value)) {}
+	String(unsigned int value) : _text(std::to_string(value)) {}
+	String(long value) : _text(std::to_string(value)) {}
+	String(unsigned long value) : _text(std::to_string(value)) {}
+
+	const char *c_str() const { return _text.c_str(); }
+	unsigned int length() const { return static_cast<unsigned int>(_text.size()); }
+
+	String &operator+=(const String &other) { _text += other._text; return *this; }
+	String &operator+=(const char *other) { _text += other; return *this; }
+	String &operator+=(char other) { _text += other; return *this; }
+	String &operator+=(int other) { _text += std::to_string(other); return *this; }
+	String &operator+=(long other) { _text += std::to_string(other); return *this; }
+
+	friend String operator+(String left, const String &right) { return left += right; }
+	friend String operator+(String left, const char *right) { return left += right; }
+	friend String operator+(String left, char right) { return left += right; }
+	friend String operator+(String left, int right) { return left += right; }
+	friend String operator+(String left, long right) { return left += right; }
+
+	bool operator==(const String &other) const { return _text == other._text; }
+
+private:
+	std::string _text;
+};
+
+/// @brief Arduino Print
+class Print;
+
+/// @brief Object that can print itself to a Print
+class Printable {
+public:
+	virtual ~Printable() {}
+	virtual size_t printTo(Print &output) const = 0;
+};
+
+class Print {
+public:
+	virtual ~Print() {}
+
+	virtual size_t write(uint8_t value) = 0;
+
+	virtual size_t write(const uint8_t *buffer, size_t size) {
+		size_t count = 0;
+		while (size-- > 0) {
+			count += write(*buffer++);
+		}
+		return count;
+	}
+
+	size_t write(const char *text) { return text != nullptr ? write(text, strlen(text)) : 0; }
+	size_t write(const char *buffer, size_t size) { return write(reinterpret_cast<const uint8_t *>(buffer), size); }
+
+	virtual int availableForWrite() { return 0; }
+	virtual void flush() {}
+
+	size_t print(const char *text) { return write(text); }
+	size_t print(const String &text) { return write(text.c_str(), text.length()); }
+	size_t print(const __FlashStringHelper *text) { return write(reinterpret_cast<const char *>(text)); }
+	size_t print(char value) { return write(static_cast<uint8_t>(value)); }
+	size_t print(const Printable &value) { return value.printTo(*this); }
+	size_t print(unsigned char value, int base = DEC) { return print(static_cast<unsigned long>(value), base); }
+	size_t print(int value, int base = DEC) { return print(static_cast<long>(value), base); }
+	size_t print(unsigned int value, int base = DEC) { return print(static_cast<unsigned long>(value), base); }
+	size_t print(long value, int base = DEC);
+	size_t print(unsigned long value, int base = DEC);
+	size_t print(double value, int digits = 2);
+
+	size_t println() { return write("\r\n"); }
+	template<class T>
+	size_t println(const T &value) { return print(value) + println(); }
+};
+
+/// @brief Arduino Stream
+class Stream : public Print {
+public:
+	virtual int available() = 0;
+	virtual int read() = 0;
+	virtual int peek() = 0;
+};
+
+/// @brief Serial, writing to stdout
+class HostSerial : public Stream {
+public:
+	void begin(unsigned long baud);
+	size_t write(uint8_t value) override;
+	size_t write(const uint8_t *buffer, size_t size) override;
+	using Print::write;
+	int available() override { return 0; }
+	int read() override { return -1; }
+	int peek() override { return -1; }
+	explicit operator bool() const { return true; }
+
+private:
+	unsigned long _byteMicros = 87;	///< Time to send a byte, in us
+};
+
+extern HostSerial Serial;
+
+/// @brief IPv4 address
+class IPAddress : public Printable {
+public:
+	IPAddress() : _bytes { 0, 0, 0, 0 } {}
+	IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : _bytes { a, b, c, d } {}
+	uint8_t operator[](int index) const { return _bytes[index]; }
+	uint8_t &operator[](int index) { return _bytes[index]; }
+	bool operator==(const IPAddress &other) const { return memcmp(_bytes, other._bytes, 4) == 0; }
+	bool operator!=(const IPAddress &other) const { return !(*this == other); }
+	size_t printTo(Print &output) const override;
+
+private:
+	uint8_t _bytes[4];
+};
+
+#endif // JBLOGGER_HOST_ARDUINO_H
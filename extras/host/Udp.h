@@ -0,0 +1,28 @@
+/// @file Udp.h
+/// @author Jonny Bergdahl
+/// @brief Minimal Arduino API for building JBLogger on a desktop host
+/// @date Created: 2026-10-18
+/// @details This file contains the Arduino UDP interface. A POSIX implementation is in
+/// extras/tools/jblog_posix_udp.h.
+///
+/// You can find the source code and/ collaborate on
+/// [https://github.com/jonnybergdahl/Bergdahl_JBLogger](https://github.com/jonnybergdahl/Bergdahl_JBLogger).
+///
+/// This code is distributed under the MIT License. See the LICENSE file for details.
+#ifndef JBLOGGER_HOST_UDP_H
+#define JBLOGGER_HOST_UDP_H
+
+#include "Arduino.h"
+
+/// @brief Arduino UDP
+class UDP : public Stream {
+public:
+	virtual uint8_t begin(uint16_t port) = 0;
+	virtual void stop() = 0;
+	virtual int beginPacket(IPAddress ip, uint16_t port) = 0;
+	virtual int beginPacket(const char *host, uint16_t port) = 0;
+	virtual int endPacket() = 0;
+	virtual int parsePacket() = 0;
+};
+
+#endif // JBLOGGER_HOST_UDP_H
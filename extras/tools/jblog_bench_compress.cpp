@@ -0,0 +1,114 @@
+/// @file jblog_bench_compress.cpp
+/// @author Jonny Bergdahl
+/// @brief Host benchmark of JBCompressStream
+/// @date Created: 2026-10-18
+/// @details Compresses a log file line by line, as a logger writes it, and prints the
+/// compression ratio and the time per input KB. Use jblog_example_corpus to create a corpus,
+/// and jblog_decompress to check the round trip.
+///
+/// Build with: c++ -std=c++14 -O2 -I ../host -I ../../src -o jblog_bench_compress jblog_bench_compress.cpp
+///             ../host/Arduino.cpp ../../src/jblogger_compress.cpp
+///
+/// Add -DJBLOGGER_COMPRESS_WINDOW_BITS=8 or another value to measure other window sizes.
+///
+/// Usage: jblog_bench_compress [-m module,module,...] input [output]
+///
+/// The module names seed the dictionary, as for JBCompressStream. The corpus of
+/// jblog_example_corpus uses the module name LOG. The compressed log is written to output
+/// if given.
+///
+/// You can find the source code and/ collaborate on
+/// [https://github.com/jonnybergdahl/Bergdahl_JBLogger](https://github.com/jonnybergdahl/Bergdahl_JBLogger).
+///
+/// This code is distributed under the MIT License. See the LICENSE file for details.
+#include <jblogger_compress.h>
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+/// @brief Print collecting the compressed data in memory
+class MemoryPrint : public Print {
+public:
+	size_t write(uint8_t value) override {
+		_data.push_back(value);
+		return 1;
+	}
+	size_t write(const uint8_t *buffer, size_t size) override {
+		_data.insert(_data.end(), buffer, buffer + size);
+		return size;
+	}
+	using Print::write;
+	const std::vector<uint8_t> &data() const { return _data; }
+
+private:
+	std::vector<uint8_t> _data;
+};
+
+int main(int argc, char **argv) {
+	std::vector<std::string> names;
+	int arg = 1;
+	if (arg + 1 < argc && strcmp(argv[arg], "-m") == 0) {
+		std::string list = argv[arg + 1];
+		for (size_t start = 0; start <= list.size(); ) {
+			size_t end = list.find(',', start);
+			if (end == std::string::npos) {
+				end = list.size();
+			}
+			names.push_back(list.substr(start, end - start));
+			start = end + 1;
+		}
+		arg += 2;
+	}
+	if (argc - arg < 1 || argc - arg > 2) {
+		fprintf(stderr, "Usage: %s [-m module,module,...] input [output]\n", argv[0]);
+		return 2;
+	}
+
+	FILE *input = fopen(argv[arg], "rb");
+	if (input == nullptr) {
+		fprintf(stderr, "jblog_bench_compress: can not open %s\n", argv[arg]);
+		return 1;
+	}
+	std::vector<uint8_t> text;
+	uint8_t buffer[4096];
+	size_t count;
+	while ((count = fread(buffer, 1, sizeof(buffer), input)) > 0) {
+		text.insert(text.end(), buffer, buffer + count);
+	}
+	fclose(input);
+
+	std::vector<const char *> modules;
+	for (const std::string &name : names) {
+		modules.push_back(name.c_str());
+	}
+
+	MemoryPrint output;
+	JBCompressStream compressed(output, modules.data(), modules.size());
+	const auto start = std::chrono::steady_clock::now();
+	size_t lineStart = 0;
+	for (size_t i = 0; i < text.size(); i++) {
+		if (text[i] == '\n') {
+			compressed.write(text.data() + lineStart, i + 1 - lineStart);
+			lineStart = i + 1;
+		}
+	}
+	compressed.write(text.data() + lineStart, text.size() - lineStart);
+	compressed.flush();
+	const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+	printf("window %u bytes: %zu -> %zu bytes, %.2f:1, %.1f us per input KB\n",
+		   JBLOGGER_COMPRESS_WINDOW_SIZE, text.size(), output.data().size(),
+		   static_cast<double>(text.size()) / output.data().size(), us * 1024 / text.size());
+
+	if (argc - arg == 2) {
+		FILE *file = fopen(argv[arg + 1], "wb");
+		if (file == nullptr || fwrite(output.data().data(), 1, output.data().size(), file) != output.data().size()) {
+			fprintf(stderr, "jblog_bench_compress: can not write %s\n", argv[arg + 1]);
+			return 1;
+		}
+		fclose(file);
+	}
+	return 0;
+}
@@ -0,0 +1,100 @@
+/// @file jblog_bench_line.cpp
+/// @author Jonny Bergdahl
+/// @brief Host benchmark of JBLogLine against String concatenation
+/// @date Created: 2026-10-18
+/// @details Logs the same line built with operator<< on a JBLogLine, built by String
+/// concatenation, and formatted by printf-style and JBFMT() log calls, and prints the time
+/// and the heap allocations per line. The builder and String lines are also logged with a
+/// log level that filters them.
+///
+/// The host String in extras/host is a std::string, which keeps short texts without
+/// allocating, so the String allocation counts are lower than on a board.
+///
+/// Build with: c++ -std=c++14 -O2 -I ../host -I ../../src -o jblog_bench_line jblog_bench_line.cpp
+///             ../host/Arduino.cpp ../../src/jblogger.cpp ../../src/jblogger_format.cpp
+///             ../../src/jblogger_sites.cpp
+///
+/// Usage: jblog_bench_line [lines]
+///
+/// You can find the source code and/ collaborate on
+/// [https://github.com/jonnybergdahl/Bergdahl_JBLogger](https://github.com/jonnybergdahl/Bergdahl_JBLogger).
+///
+/// This code is distributed under the MIT License. See the LICENSE file for details.
+#include <jblogger.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <new>
+#include <string>
+
+static unsigned long allocations = 0;
+
+void *operator new(size_t size) {
+	allocations++;
+	void *pointer = malloc(size);
+	if (pointer == nullptr) {
+		throw std::bad_alloc();
+	}
+	return pointer;
+}
+
+void operator delete(void *pointer) noexcept {
+	free(pointer);
+}
+
+void operator delete(void *pointer, size_t) noexcept {
+	free(pointer);
+}
+
+typedef JBMemorySink<1 << 16> MemorySink;
+
+static MemorySink sink;
+
+/// @brief Prints the time and the allocations per call of a function
+template<class Function>
+static void measure(const char *name, long count, Function function) {
+	const unsigned long before = allocations;
+	const auto start = std::chrono::steady_clock::now();
+	for (long i = 0; i < count; i++) {
+		function(static_cast<int>(i));
+		if (sink.length() > 60000) {
+			sink.clear();
+		}
+	}
+	const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / count;
+	printf("%-36s %7.1f ns/line   %.2f allocations/line\n", name, ns,
+		   static_cast<double>(allocations - before) / count);
+}
+
+int main(int argc, char **argv) {
+	const long count = argc > 1 ? atol(argv[1]) : 2000000;
+
+	JBBasicLogger<MemorySink> logger("NET", LOG_LEVEL_INFO, sink);
+	const char *ip = "192.168.1.10";
+	const std::string ssid = "HomeNetwork";
+	const String host = "sensor-livingroom-1";
+
+	measure("JBLogLine", count, [&](int i) {
+		logger.info() << "rssi=" << i << " ip=" << ip << " ssid=" << ssid << " host=" << host;
+	});
+	measure("String concatenation", count, [&](int i) {
+		String line = String("rssi=") + i + " ip=" + ip + " ssid=" + ssid.c_str() + " host=" + host;
+		logger.info(line);
+	});
+	measure("printf-style", count, [&](int i) {
+		logger.info("rssi=%d ip=%s ssid=%s host=%s", i, ip, ssid.c_str(), host.c_str());
+	});
+	measure("JBFMT", count, [&](int i) {
+		logger.info(JBFMT("rssi=%d ip=%s ssid=%s host=%s"), i, ip, ssid.c_str(), host.c_str());
+	});
+
+	logger.setLogLevel(LOG_LEVEL_WARNING);
+	measure("JBLogLine, filtered", count, [&](int i) {
+		logger.info() << "rssi=" << i << " ip=" << ip << " ssid=" << ssid << " host=" << host;
+	});
+	measure("String concatenation, filtered", count, [&](int i) {
+		String line = String("rssi=") + i + " ip=" + ip + " ssid=" + ssid.c_str() + " host=" + host;
+		logger.info(line);
+	});
+	return 0;
+}
@@ -0,0 +1,94 @@
+/// @file jblog_bench_sink.cpp
+/// @author Jonny Bergdahl
+/// @brief Host benchmark of the cost of the sink write per log line
+/// @date Created: 2026-10-18
+/// @details Logs the same lines with JBLogger, writing to a Stream, and with
+/// JBBasicLogger<CountingSink>, writing to a concrete sink type, and prints the time per line.
+/// Both sinks only count the bytes, so the difference is the cost of the virtual write calls.
+///
+/// Build with: c++ -std=c++14 -O2 -I ../host -I ../../src -o jblog_bench_sink jblog_bench_sink.cpp
+///             ../host/Arduino.cpp ../../src/jblogger.cpp ../../src/jblogger_format.cpp
+///             ../../src/jblogger_sites.cpp
+///
+/// Usage: jblog_bench_sink [lines]
+///
+/// You can find the source code and/ collaborate on
+/// [https://github.com/jonnybergdahl/Bergdahl_JBLogger](https://github.com/jonnybergdahl/Bergdahl_JBLogger).
+///
+/// This code is distributed under the MIT License. See the LICENSE file for details.
+#include <jblogger.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+
+/// @brief Stream counting the bytes written, one virtual call per byte like most Streams
+class CountingStream : public Stream {
+public:
+	size_t write(uint8_t) override {
+		_count++;
+		return 1;
+	}
+	using Print::write;
+	int available() override { return 0; }
+	int read() override { return -1; }
+	int peek() override { return -1; }
+	size_t count() const { return _count; }
+
+private:
+	size_t _count = 0;
+};
+
+/// @brief Concrete sink counting the bytes written
+class CountingSink {
+public:
+	size_t write(const uint8_t *, size_t size) {
+		_count += size;
+		return size;
+	}
+	size_t count() const { return _count; }
+
+private:
+	size_t _count = 0;
+};
+
+/// @brief Returns the time per call of a function, in ns
+template<class Function>
+static double measure(long count, Function function) {
+	const auto start = std::chrono::steady_clock::now();
+	for (long i = 0; i < count; i++) {
+		function(i);
+	}
+	return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / count;
+}
+
+/// @brief Runs the benchmark for a logger
+template<class Logger>
+static void run(const char *name, Logger &logger, long count) {
+	static uint8_t buffer[64];
+	const double info = measure(count, [&](long i) {
+		logger.info("This is a formatted info message: %d", static_cast<int>(i));
+	});
+	// traceDump() writes 4 lines for 64 bytes
+	const double dump = measure(count / 4, [&](long) {
+		logger.traceDump(buffer, sizeof(buffer));
+	}) / 4;
+	printf("%-32s info: %6.1f ns/line   traceDump: %6.1f ns/line\n", name, info, dump);
+}
+
+int main(int argc, char **argv) {
+	const long count = argc > 1 ? atol(argv[1]) : 2000000;
+
+	CountingStream stream;
+	JBLogger streamLogger("LOG", LOG_LEVEL_TRACE, stream, true, true, false);
+	run("JBLogger, Stream", streamLogger, count);
+
+	CountingSink sink;
+	JBBasicLogger<CountingSink> sinkLogger("LOG", LOG_LEVEL_TRACE, sink, true, true, false);
+	run("JBBasicLogger<CountingSink>", sinkLogger, count);
+
+	if (stream.count() != sink.count()) {
+		fprintf(stderr, "jblog_bench_sink: output differs, %zu and %zu bytes\n", stream.count(), sink.count());
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,127 @@
+/// @file jblog_bench_syslog.cpp
+/// @author Jonny Bergdahl
+/// @brief Host loopback benchmark of JBSyslogStream
+/// @date Created: 2026-10-18
+/// @details Logs through JBBasicLogger<JBSyslogStream> over a POSIX UDP socket, and prints
+/// the datagram counts and the time per line:
+///
+/// - outage: lines logged while sending fails, to show the backlog and the dropped count.
+/// - batched: lines logged with JBSyslogStream, loop() called every 100 lines.
+/// - unbatched: the same lines sent as one datagram each, for reference.
+///
+/// Run jblog_udp_receiver in another terminal to check that no datagram is lost, other than
+/// the ones dropped during the outage.
+///
+/// Build with: c++ -std=c++14 -O2 -I ../host -I ../../src -o jblog_bench_syslog jblog_bench_syslog.cpp
+///             ../host/Arduino.cpp ../../src/jblogger.cpp ../../src/jblogger_format.cpp
+///             ../../src/jblogger_sites.cpp ../../src/jblogger_syslog.cpp
+///
+/// Usage: jblog_bench_syslog [-n lines] [host [port]]
+///
+/// The host defaults to localhost and the port to 5514.
+///
+/// You can find the source code and/ collaborate on
+/// [https://github.com/jonnybergdahl/Bergdahl_JBLogger](https://github.com/jonnybergdahl/Bergdahl_JBLogger).
+///
+/// This code is distributed under the MIT License. See the LICENSE file for details.
+#include <jblogger_syslog.h>
+#include "jblog_posix_udp.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+
+static unsigned long resolves = 0;
+
+/// @brief Resolver counting the lookups, to show they are only done from loop()
+static bool countingResolve(const char *host, IPAddress &address) {
+	resolves++;
+	return PosixUDP::resolve(host, address);
+}
+
+static double seconds(std::chrono::steady_clock::time_point start) {
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char **argv) {
+	long lines = 200000;
+	int arg = 1;
+	if (arg + 1 < argc && strcmp(argv[arg], "-n") == 0) {
+		lines = atol(argv[arg + 1]);
+		arg += 2;
+	}
+	const char *host = arg < argc ? argv[arg++] : "localhost";
+	const uint16_t port = static_cast<uint16_t>(arg < argc ? atoi(argv[arg++]) : 5514);
+	if (arg != argc || lines <= 0) {
+		fprintf(stderr, "Usage: %s [-n lines] [host [port]]\n", argv[0]);
+		return 2;
+	}
+
+	PosixUDP udp;
+	if (!udp.begin(0)) {
+		perror("jblog_bench_syslog: socket");
+		return 1;
+	}
+	JBSyslogStream syslog(udp, host, port, "bench-host", "bench");
+	syslog.setResolver(countingResolve);
+	JBBasicLogger<JBSyslogStream> logger("NET", LOG_LEVEL_INFO, syslog);
+
+	// Outage, the backlog keeps the newest datagrams
+	udp.setFailing(true);
+	for (int i = 0; i < 5000; i++) {
+		logger.warning("Outage line %d", i);
+		if (i % 100 == 0) {
+			syslog.loop();
+		}
+	}
+	syslog.flush();
+	printf("outage:    %lu lines, %lu datagrams created, %lu dropped\n", 5000UL,
+		   static_cast<unsigned long>(syslog.getSequence()), static_cast<unsigned long>(syslog.getDatagramsDropped()));
+	udp.setFailing(false);
+	syslog.flush();
+	syslog.loop();
+	printf("           %lu datagrams sent after the outage\n", static_cast<unsigned long>(syslog.getDatagramsSent()));
+
+	// Batched
+	const unsigned long sent = syslog.getDatagramsSent();
+	const unsigned long resolvesBefore = resolves;
+	auto start = std::chrono::steady_clock::now();
+	for (long i = 0; i < lines; i++) {
+		logger.info("Sensor reading %ld, temperature %d.%d C", i, static_cast<int>(20 + i % 5), static_cast<int>(i % 10));
+		if (i % 100 == 0) {
+			syslog.loop();
+		}
+	}
+	syslog.flush();
+	double time = seconds(start);
+	const unsigned long datagrams = syslog.getDatagramsSent() - sent;
+	printf("batched:   %ld lines, %lu datagrams, %.1f lines each, %.3f s, %.0f ns/line, %lu lookups\n",
+		   lines, datagrams, static_cast<double>(lines) / datagrams, time, time * 1e9 / lines,
+		   resolves - resolvesBefore);
+	if (syslog.getSequence() != syslog.getDatagramsSent() + syslog.getDatagramsDropped()) {
+		fprintf(stderr, "jblog_bench_syslog: datagrams missing from the counts\n");
+		return 1;
+	}
+
+	// Unbatched reference, one datagram per line
+	IPAddress address;
+	if (!PosixUDP::resolve(host, address)) {
+		fprintf(stderr, "jblog_bench_syslog: can not resolve %s\n", host);
+		return 1;
+	}
+	uint32_t sequence = syslog.getSequence();
+	char line[256];
+	start = std::chrono::steady_clock::now();
+	for (long i = 0; i < lines; i++) {
+		const int length = snprintf(line, sizeof(line),
+									"<134>1 - bench-host bench - - [meta sequenceId=\"%lu\"] (%lu) I NET: Sensor reading %ld, temperature %d.%d C",
+									static_cast<unsigned long>(++sequence), millis(), i,
+									static_cast<int>(20 + i % 5), static_cast<int>(i % 10));
+		udp.beginPacket(address, port);
+		udp.write(reinterpret_cast<const uint8_t *>(line), static_cast<size_t>(length));
+		udp.endPacket();
+	}
+	time = seconds(start);
+	printf("unbatched: %ld lines, %ld datagrams, %.3f s, %.0f ns/line\n", lines, lines, time, time * 1e9 / lines);
+	return 0;
+}
@@ -0,0 +1,218 @@
+/// @file jblog_decompress.cpp
+/// @author Jonny Bergdahl
+/// @brief Host tool restoring logs written by JBCompressStream
+/// @date Created: 2026-10-18
+/// @details Reads a compressed log and writes the original log text.
+///
+/// Build with: c++ -std=c++14 -O2 -o jblog_decompress jblog_decompress.cpp
+///
+/// Usage: jblog_decompress [-m module,module,...] [input [output]]
+///
+/// The module names must be the ones given to the JBCompressStream, in the same order, as
+/// they are used to build the dictionary. Reads from stdin and writes to stdout when no
+/// files are given. A log that was cut off, for example by a device reset before flush(),
+/// is restored up to the last complete token.
+///
+/// You can find the source code and/ collaborate on
+/// [https://github.com/jonnybergdahl/Bergdahl_JBLogger](https://github.com/jonnybergdahl/Bergdahl_JBLogger).
+///
+/// This code is distributed under the MIT License. See the LICENSE file for details.
+#include "../../src/jblogger_compress_format.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+/// @brief Reads a bit stream, most significant bit first
+class BitReader {
+public:
+	explicit BitReader(FILE *input) : _input(input) {}
+
+	/// @brief Reads count bits, returns false at the end of the input
+	bool read(uint8_t count, uint32_t &value) {
+		value = 0;
+		while (count > 0) {
+			if (_bitCount == 0) {
+				const int c = fgetc(_input);
+				if (c == EOF) {
+					return false;
+				}
+				_bits = static_cast<uint8_t>(c);
+				_bitCount = 8;
+			}
+			value = (value << 1) | ((_bits >> --_bitCount) & 1);
+			count--;
+		}
+		return true;
+	}
+
+	/// @brief Skips to the next byte boundary
+	void align() {
+		_bitCount = 0;
+	}
+
+private:
+	FILE *_input;
+	uint8_t _bits = 0;
+	uint8_t _bitCount = 0;
+};
+
+/// @brief Restores timestamps and escaped bytes in the decompressed text
+class TextWriter {
+public:
+	explicit TextWriter(FILE *output) : _output(output) {}
+
+	void write(uint8_t value) {
+		switch (_state) {
+			case STATE_TEXT:
+				if (value == JBLOGGER_COMPRESS_TIMESTAMP) {
+					_state = STATE_TIMESTAMP;
+					_delta = 0;
+					_shift = 0;
+				} else if (value == JBLOGGER_COMPRESS_ESCAPE) {
+					_state = STATE_ESCAPE;
+				} else {
+					fputc(value, _output);
+				}
+				break;
+
+			case STATE_ESCAPE:
+				fputc(value, _output);
+				_state = STATE_TEXT;
+				break;
+
+			case STATE_TIMESTAMP:
+				_delta |= static_cast<uint32_t>(value & 0x7f) << _shift;
+				_shift += 7;
+				if ((value & 0x80) == 0 || _shift >= 35) {
+					_timestamp += _delta;
+					fprintf(_output, "(%lu) ", static_cast<unsigned long>(_timestamp));
+					_state = STATE_TEXT;
+				}
+				break;
+		}
+	}
+
+private:
+	enum State { STATE_TEXT, STATE_ESCAPE, STATE_TIMESTAMP };
+
+	FILE *_output;
+	State _state = STATE_TEXT;
+	uint32_t _timestamp = 0;
+	uint32_t _delta = 0;
+	uint8_t _shift = 0;
+};
+
+static int decompress(FILE *input, FILE *output, const std::vector<const char *> &moduleNames) {
+	uint8_t header[JBLOGGER_COMPRESS_HEADER_LENGTH];
+	if (fread(header, 1, sizeof(header), input) != sizeof(header) ||
+		memcmp(header, JBLOGGER_COMPRESS_MAGIC, 4) != 0) {
+		fprintf(stderr, "jblog_decompress: not a compressed log\n");
+		return 1;
+	}
+	if (header[4] != JBLOGGER_COMPRESS_VERSION) {
+		fprintf(stderr, "jblog_decompress: unsupported version %u\n", header[4]);
+		return 1;
+	}
+	const uint8_t windowBits = header[5];
+	const uint8_t lengthBits = header[6];
+	const size_t dictionaryLength = header[7] | (header[8] << 8);
+	const uint16_t dictionaryChecksum = static_cast<uint16_t>(header[9] | (header[10] << 8));
+	if (windowBits < 4 || windowBits > 16 || lengthBits < 1 || lengthBits > 8) {
+		fprintf(stderr, "jblog_decompress: invalid window or length bits\n");
+		return 1;
+	}
+
+	const size_t windowSize = static_cast<size_t>(1) << windowBits;
+	const size_t windowMask = windowSize - 1;
+	std::vector<uint8_t> window(windowSize);
+	const size_t length = JBCompressBuildDictionary(window.data(), windowSize / 2,
+													moduleNames.data(), moduleNames.size());
+	if (length != dictionaryLength || JBCompressChecksum(window.data(), length) != dictionaryChecksum) {
+		fprintf(stderr, "jblog_decompress: dictionary mismatch, check the module names given with -m\n");
+		return 1;
+	}
+	size_t position = dictionaryLength;
+
+	BitReader bits(input);
+	TextWriter text(output);
+	for (;;) {
+		uint32_t flag;
+		if (!bits.read(1, flag)) {
+			break;
+		}
+		if (flag) {
+			uint32_t value;
+			if (!bits.read(8, value)) {
+				break;
+			}
+			window[position++ & windowMask] = static_cast<uint8_t>(value);
+			text.write(static_cast<uint8_t>(value));
+			continue;
+		}
+
+		uint32_t distance;
+		uint32_t code;
+		if (!bits.read(windowBits, distance) || !bits.read(lengthBits, code)) {
+			break;
+		}
+		if (code == 0) {
+			bits.align();
+			continue;
+		}
+		distance++;
+		if (distance > position) {
+			fprintf(stderr, "jblog_decompress: corrupt input, reference before start\n");
+			return 1;
+		}
+		for (uint32_t i = 0; i < code + JBLOGGER_COMPRESS_MIN_MATCH - 1; i++) {
+			const uint8_t value = window[(position - distance) & windowMask];
+			window[position++ & windowMask] = value;
+			text.write(value);
+		}
+	}
+	return 0;
+}
+
+int main(int argc, char **argv) {
+	FILE *input = stdin;
+	FILE *output = stdout;
+	std::string modules;
+	int arg = 1;
+	if (arg + 1 < argc && strcmp(argv[arg], "-m") == 0) {
+		modules = argv[arg + 1];
+		arg += 2;
+	}
+	if (argc - arg > 2 || (arg < argc && argv[arg][0] == '-')) {
+		fprintf(stderr, "Usage: %s [-m module,module,...] [input [output]]\n", argv[0]);
+		return 2;
+	}
+
+	std::vector<const char *> moduleNames;
+	for (size_t start = 0; start < modules.size(); ) {
+		size_t end = modules.find(',', start);
+		if (end == std::string::npos) {
+			end = modules.size();
+		}
+		if (end < modules.size()) {
+			modules[end] = '\0';
+		}
+		moduleNames.push_back(modules.c_str() + start);
+		start = end + 1;
+	}
+
+	if (arg < argc && (input = fopen(argv[arg], "rb")) == nullptr) {
+		perror(argv[arg]);
+		return 1;
+	}
+	if (arg + 1 < argc && (output = fopen(argv[arg + 1], "wb")) == nullptr) {
+		perror(argv[arg + 1]);
+		return 1;
+	}
+
+	const int result = decompress(input, output, moduleNames);
+	fclose(input);
+	fclose(output);
+	return result;
+}
@@ -0,0 +1,32 @@
+/// @file jblog_example_corpus.cpp
+/// @author Jonny Bergdahl
+/// @brief Host tool writing the output of LoggingExample, as a compression test corpus
+/// @date Created: 2026-10-18
+/// @details Runs setup() and loop() of examples/LoggingExample on the host and writes the log
+/// output to stdout. The clock is simulated: it starts at 0 and moves with delay() and with
+/// the time the Serial output would take at 115200 baud, so the output is the same on
+/// every run.
+///
+/// Build with: c++ -std=c++14 -O2 -I ../host -I ../../src -o jblog_example_corpus jblog_example_corpus.cpp
+///             ../host/Arduino.cpp ../../src/jblogger.cpp ../../src/jblogger_format.cpp
+///             ../../src/jblogger_sites.cpp
+///
+/// Usage: jblog_example_corpus [loops] > corpus.txt
+///
+/// The default is 30 loops, about 110 KB.
+///
+/// You can find the source code and/ collaborate on
+/// [https://github.com/jonnybergdahl/Bergdahl_JBLogger](https://github.com/jonnybergdahl/Bergdahl_JBLogger).
+///
+/// This code is distributed under the MIT License. See the LICENSE file for details.
+#include "../../examples/LoggingExample/LoggingExample.ino"
+
+int main(int argc, char **argv) {
+	const int loops = argc > 1 ? atoi(argv[1]) : 30;
+	host::setSimulatedClock(true);
+	setup();
+	for (int i = 0; i < loops; i++) {
+		loop();
+	}
+	return 0;
+}
@@ -0,0 +1,423 @@
+/// @file jblog_host_check.cpp
+/// @author Jonny Bergdahl
+/// @brief Host checks of the JBLogger output
+/// @date Created: 2026-10-18
+/// @details Logs known messages into a JBMemorySink and checks the lines written.
+///
+/// Build with: c++ -std=c++14 -O2 -I ../host -I ../../src -o jblog_host_check jblog_host_check.cpp
+///             ../host/Arduino.cpp ../../src/jblogger.cpp ../../src/jblogger_format.cpp
+///             ../../src/jblogger_sites.cpp
+///
+/// Usage: jblog_host_check
+///
+/// Prints each failed check and exits with 1 if any check failed.
+///
+/// You can find the source code and/ collaborate on
+/// [https://github.com/jonnybergdahl/Bergdahl_JBLogger](https://github.com/jonnybergdahl/Bergdahl_JBLogger).
+///
+/// This code is distributed under the MIT License. See the LICENSE file for details.
+#include <jblogger.h>
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+typedef JBMemorySink<4096> MemorySink;
+
+static int failures = 0;
+
+/// @brief Reports a failed check
+static void check(bool passed, const char *name, const std::string &output) {
+	if (!passed) {
+		failures++;
+		fprintf(stderr, "FAILED: %s\n  output: \"", name);
+		for (char c : output) {
+			if (c >= ' ' && c < 0x7f) {
+				fputc(c, stderr);
+			} else {
+				fprintf(stderr, "\\x%02x", static_cast<uint8_t>(c));
+			}
+		}
+		fprintf(stderr, "\"\n");
+	}
+}
+
+/// @brief Returns the output of a sink and empties it
+static std::string take(MemorySink &sink) {
+	std::string output(sink.data(), sink.length());
+	sink.clear();
+	return output;
+}
+
+/// @brief Checks that a line is the prefix, then a message of count characters c, then "\r\n"
+static void checkLine(const char *name, const std::string &output, const char *prefix, char c, size_t count) {
+	const size_t prefixLength = strlen(prefix);
+	bool passed = output.size() == prefixLength + count + 2 &&
+				  output.compare(0, prefixLength, prefix) == 0 &&
+				  output.compare(output.size() - 2, 2, "\r\n") == 0;
+	for (size_t i = prefixLength; passed && i < prefixLength + count; i++) {
+		passed = output[i] == c;
+	}
+	check(passed, name, output);
+}
+
+/// @brief Over long messages are cut at MAX_MESSAGE_LENGTH - 1 characters by every log call
+static void checkLongMessages() {
+	MemorySink sink;
+	JBBasicLogger<MemorySink> logger("LOG", LOG_LEVEL_TRACE, sink, true, true, false);
+	const std::string text(300, 'x');
+	const size_t cut = MAX_MESSAGE_LENGTH - 1;
+
+	logger.info("%s", text.c_str());
+	checkLine("printf-style message is cut", take(sink), "I LOG: ", 'x', cut);
+
+	logger.info(F("%s"), text.c_str());
+	checkLine("flash message is cut", take(sink), "I LOG: ", 'x', cut);
+
+	std::string format = "%s";
+	logger.info(format, text.c_str());
+	checkLine("std::string message is cut", take(sink), "I LOG: ", 'x', cut);
+
+#ifdef JBLOGGER_HAS_JBFMT
+	logger.info(JBFMT("%s"), text.c_str());
+	checkLine("JBFMT message is cut", take(sink), "I LOG: ", 'x', cut);
+#endif
+
+	logger.info() << text;
+	checkLine("JBLogLine message is cut", take(sink), "I LOG: ", 'x', cut);
+
+	logger.info("%s", text.substr(0, cut).c_str());
+	checkLine("message of the maximum length is kept", take(sink), "I LOG: ", 'x', cut);
+
+	logger.info("%s", text.substr(0, 10).c_str());
+	checkLine("short message is kept", take(sink), "I LOG: ", 'x', 10);
+}
+
+/// @brief Printable with a conversion to an integer, like IPAddress on some cores
+class ConvertiblePrintable : public Printable {
+public:
+	operator uint32_t() const {
+		return 42;
+	}
+	size_t printTo(Print &output) const override {
+		return output.print("printable");
+	}
+};
+
+/// @brief JBLogLine prints Printable values into the line, and cuts numbers like strings
+static void checkLogLineValues() {
+	MemorySink sink;
+	JBBasicLogger<MemorySink> logger("LOG", LOG_LEVEL_TRACE, sink, true, true, false);
+	std::string output;
+
+	logger.info() << "ip=" << IPAddress(192, 168, 1, 10) << " x=" << ConvertiblePrintable();
+	output = take(sink);
+	check(output == "I LOG: ip=192.168.1.10 x=printable\r\n", "Printable is printed into the line", output);
+
+	const std::string text(MAX_MESSAGE_LENGTH - 4, 'x');
+	logger.info() << text << -123456;
+	output = take(sink);
+	check(output == "I LOG: " + text + "-12\r\n", "integer is cut like a string", output);
+
+	logger.info() << text << 2.5;
+	output = take(sink);
+	check(output == "I LOG: " + text + "2.5\r\n", "floating point value is cut like a string", output);
+
+	logger.info() << text << IPAddress(10, 0, 0, 1);
+	output = take(sink);
+	check(output == "I LOG: " + text + "10.\r\n", "Printable is cut like a string", output);
+}
+
+#ifdef JBLOGGER_HAS_JBFMT
+/// @brief Checks that JBFMT() formats like snprintf, the format must be a string literal
+#define CHECK_JBFMT(logger, sink, format, ...) \
+	do { \
+		char expected[MAX_MESSAGE_LENGTH]; \
+		snprintf(expected, sizeof(expected), format, __VA_ARGS__); \
+		(logger).info(JBFMT(format), __VA_ARGS__); \
+		const std::string output = take(sink); \
+		check(output == std::string("I LOG: ") + expected + "\r\n", "JBFMT(\"" format "\") formats like snprintf", output); \
+	} while (0)
+
+/// @brief JBFMT() formats integers, characters, strings and pointers like snprintf
+///
+/// %hh and a null %p are left out, they are documented to differ.
+///
+static void checkJBFMT() {
+	MemorySink sink;
+	JBBasicLogger<MemorySink> logger("LOG", LOG_LEVEL_TRACE, sink, true, true, false);
+	int value = 42;
+
+	CHECK_JBFMT(logger, sink, "%d", 0);
+	CHECK_JBFMT(logger, sink, "%d", INT_MIN);
+	CHECK_JBFMT(logger, sink, "%i", INT_MAX);
+	CHECK_JBFMT(logger, sink, "[%5d]", 42);
+	CHECK_JBFMT(logger, sink, "[%-5d]", 42);
+	CHECK_JBFMT(logger, sink, "[%05d]", -42);
+	CHECK_JBFMT(logger, sink, "[%-05d]", -42);
+	CHECK_JBFMT(logger, sink, "[%+d]", 42);
+	CHECK_JBFMT(logger, sink, "[%+d]", -42);
+	CHECK_JBFMT(logger, sink, "[% d]", 42);
+	CHECK_JBFMT(logger, sink, "[% 5d]", 42);
+	CHECK_JBFMT(logger, sink, "[%+ d]", 42);
+	CHECK_JBFMT(logger, sink, "[%.0d]", 0);
+	CHECK_JBFMT(logger, sink, "[%5.0d]", 0);
+	CHECK_JBFMT(logger, sink, "[%.3d]", 7);
+	CHECK_JBFMT(logger, sink, "[%.3d]", -7);
+	CHECK_JBFMT(logger, sink, "[%8.3d]", -7);
+	CHECK_JBFMT(logger, sink, "[%08.3d]", 7);
+	CHECK_JBFMT(logger, sink, "[%-8.3d]", 7);
+	CHECK_JBFMT(logger, sink, "%hd", static_cast<short>(-1234));
+	CHECK_JBFMT(logger, sink, "%ld", LONG_MIN);
+	CHECK_JBFMT(logger, sink, "%lld", LLONG_MIN);
+	CHECK_JBFMT(logger, sink, "%lld", LLONG_MAX);
+	CHECK_JBFMT(logger, sink, "%u", UINT_MAX);
+	CHECK_JBFMT(logger, sink, "%lu", ULONG_MAX);
+	CHECK_JBFMT(logger, sink, "%llu", ULLONG_MAX);
+	CHECK_JBFMT(logger, sink, "%x", 0xbeefu);
+	CHECK_JBFMT(logger, sink, "%X", 0xbeefu);
+	CHECK_JBFMT(logger, sink, "[%#x]", 0xbeefu);
+	CHECK_JBFMT(logger, sink, "[%#X]", 0xbeefu);
+	CHECK_JBFMT(logger, sink, "[%#x]", 0u);
+	CHECK_JBFMT(logger, sink, "[%#010x]", 0xbeefu);
+	CHECK_JBFMT(logger, sink, "[%-#10x]", 0xbeefu);
+	CHECK_JBFMT(logger, sink, "[%.6x]", 0xbeefu);
+	CHECK_JBFMT(logger, sink, "[%llx]", ULLONG_MAX);
+	CHECK_JBFMT(logger, sink, "[%o]", 8u);
+	CHECK_JBFMT(logger, sink, "[%#o]", 8u);
+	CHECK_JBFMT(logger, sink, "[%#o]", 0u);
+	CHECK_JBFMT(logger, sink, "[%#.3o]", 8u);
+	CHECK_JBFMT(logger, sink, "[%c]", 'x');
+	CHECK_JBFMT(logger, sink, "[%3c]", 'x');
+	CHECK_JBFMT(logger, sink, "[%-3c]", 'x');
+	CHECK_JBFMT(logger, sink, "[%s]", "text");
+	CHECK_JBFMT(logger, sink, "[%.1s]", "text");
+	CHECK_JBFMT(logger, sink, "[%.0s]", "text");
+	CHECK_JBFMT(logger, sink, "[%6s]", "text");
+	CHECK_JBFMT(logger, sink, "[%-6s]", "text");
+	CHECK_JBFMT(logger, sink, "[%6.2s]", "text");
+	CHECK_JBFMT(logger, sink, "[%p]", static_cast<const void *>(&value));
+	CHECK_JBFMT(logger, sink, "[%20p]", static_cast<const void *>(&value));
+	CHECK_JBFMT(logger, sink, "[%-20p]", static_cast<const void *>(&value));
+	CHECK_JBFMT(logger, sink, "[%.2f]", 3.14159);
+	CHECK_JBFMT(logger, sink, "[%8.3e]", -0.000123);
+	CHECK_JBFMT(logger, sink, "%d%% of %s, %c%u", 50, "total", '#', 7u);
+}
+#endif
+
+/// @brief A long prefix leaves less room than MAX_MESSAGE_LENGTH, the line is cut at MAX_LINE_LENGTH
+static void checkLongPrefix() {
+	MemorySink sink;
+	const std::string module(MAX_PREFIX_LENGTH + 20, 'M');
+	JBBasicLogger<MemorySink> logger(module.c_str(), LOG_LEVEL_TRACE, sink, true, true, false);
+	const std::string prefix = "I " + module + ": ";
+	const size_t cut = MAX_LINE_LENGTH - 1 - prefix.size();
+	const std::string text(300, 'x');
+
+	logger.info("%s", text.c_str());
+	checkLine("printf-style line is cut after a long prefix", take(sink), prefix.c_str(), 'x', cut);
+
+	logger.info() << text;
+	checkLine("JBLogLine line is cut after a long prefix", take(sink), prefix.c_str(), 'x', cut);
+}
+
+/// @brief A site that is turned on logs below the log level, without changing the log level
+static void checkSites() {
+	MemorySink sink;
+	JBBasicLogger<MemorySink> logger("LOG", LOG_LEVEL_INFO, sink, true, true, false);
+	for (int i = 0; i < 2; i++) {
+		JBLOG_TRACE(logger, "site %d", i);
+		const std::string output = take(sink);
+		check(output == (i == 0 ? "" : "T LOG: site 1\r\n"), "site logs only when turned on", output);
+		check(logger.getLogLevel() == LOG_LEVEL_INFO, "site keeps the log level", "");
+		JBLogSites::reset(JBLOG_SITE_ON);
+	}
+	JBLogSites::reset();
+}
+
+/// @brief Print collecting the output of site commands
+class TextPrint : public Print {
+public:
+	size_t write(uint8_t value) override {
+		text += static_cast<char>(value);
+		return 1;
+	}
+	using Print::write;
+	std::string text;
+};
+
+/// @brief Runs a site command, and checks its result and output
+static void checkCommand(const char *command, bool valid, const char *output) {
+	TextPrint print;
+	const bool result = JBLogSites::command(command, print);
+	std::string name = std::string("command \"") + command + "\"";
+	check(result == valid && print.text == output, name.c_str(), print.text);
+}
+
+/// @brief Checks the mode of a site
+static void checkMode(const JBLogSite &site, JBLogSiteMode mode, const char *name) {
+	check(site.mode == mode, name, std::string("mode ") + std::to_string(site.mode));
+}
+
+/// @brief Site commands select sites by file glob, line range and format, and are remembered
+static void checkSiteCommands() {
+	static JBLogSite rssi = { "src/wifi.cpp", "\"rssi %d\"", 120, LOG_LEVEL_DEBUG, JBLOG_SITE_NEW, nullptr };
+	static JBLogSite scan = { "src/wifi.cpp", "\"scan\"", 15, LOG_LEVEL_TRACE, JBLOG_SITE_NEW, nullptr };
+	static JBLogSite http = { "lib/net_http.cpp", "\"get %s\"", 18, LOG_LEVEL_DEBUG, JBLOG_SITE_NEW, nullptr };
+	static JBLogSite connect = { "lib/netcore.cpp", "\"connect %s\"", 300, LOG_LEVEL_DEBUG, JBLOG_SITE_NEW, nullptr };
+	JBLogSites::reset();
+	JBLogSites::add(rssi);
+	JBLogSites::add(scan);
+	JBLogSites::add(http);
+
+	checkCommand("file wifi.cpp line 120 on", true, "1 sites on\r\n");
+	checkMode(rssi, JBLOG_SITE_ON, "file and line select a site");
+	checkMode(scan, JBLOG_SITE_DEFAULT, "other line of the file is kept");
+
+	checkCommand("line 10-20 off", true, "2 sites off\r\n");
+	checkMode(scan, JBLOG_SITE_OFF, "line range selects the first site");
+	checkMode(http, JBLOG_SITE_OFF, "line range selects the second site");
+	checkMode(rssi, JBLOG_SITE_ON, "site outside the line range is kept");
+
+	checkCommand("file net*.cpp default", true, "1 sites default\r\n");
+	checkMode(http, JBLOG_SITE_DEFAULT, "file glob matches the file name");
+	checkCommand("file */wifi.cpp format scan on", true, "1 sites on\r\n");
+	checkMode(scan, JBLOG_SITE_ON, "file glob matches the path, format selects the site");
+	checkCommand("file wifi.c on", true, "0 sites on\r\n");
+	checkCommand("file wifi.cp? line 120 off", true, "1 sites off\r\n");
+	checkMode(rssi, JBLOG_SITE_OFF, "'?' matches a single character");
+
+	TextPrint print;
+	JBLogSites::list(print, "wifi.cpp");
+	check(print.text.find("src/wifi.cpp:120 [off] D \"rssi %d\"\r\n") != std::string::npos &&
+		  print.text.find("src/wifi.cpp:15 [on] T \"scan\"\r\n") != std::string::npos &&
+		  print.text.find("net_http") == std::string::npos, "list shows the sites of a file", print.text);
+
+	// Invalid commands change nothing
+	const char *usage = "usage: list [file] | reset | [file <file>] [line <line>[-<line>]] [format <text>] on|off|default\r\n";
+	checkCommand("", false, "");
+	checkCommand("file wifi.cpp", false, usage);
+	checkCommand("file wifi.cpp maybe", false, "mode must be on, off or default\r\n");
+	checkCommand("line abc on", false, usage);
+	checkCommand("line 0 on", false, usage);
+	checkCommand("line 12x on", false, usage);
+	checkCommand("bogus on", false, usage);
+	checkCommand("file on", false, usage);
+	checkCommand("reset now", false, usage);
+	checkMode(rssi, JBLOG_SITE_OFF, "invalid commands keep the modes");
+	checkMode(scan, JBLOG_SITE_ON, "invalid commands keep the modes");
+
+	// A remembered change applies to a site when it first runs, later changes win
+	checkCommand("format connect on", true, "0 sites on\r\n");
+	JBLogSites::add(connect);
+	checkMode(connect, JBLOG_SITE_ON, "remembered change applies to a new site");
+	JBLogSites::add(connect);
+	check(JBLogSites::first() == &connect && connect.next == &http, "site is added once", "");
+
+	checkCommand("reset", true, "all sites default\r\n");
+	checkMode(rssi, JBLOG_SITE_DEFAULT, "reset sets all sites to default");
+	checkMode(connect, JBLOG_SITE_DEFAULT, "reset sets all sites to default");
+}
+
+/// @brief Sites first running on several threads at once are all added, once
+static void checkConcurrentSites() {
+	const int threads = 4;
+	const int ownSites = 20000;
+	const int sharedSites = 200;
+	static std::vector<JBLogSite> sites((threads * ownSites) + sharedSites);
+	for (JBLogSite &site : sites) {
+		site = { "thread.cpp", "\"thread\"", 500, LOG_LEVEL_TRACE, JBLOG_SITE_NEW, nullptr };
+	}
+	size_t before = 0;
+	for (const JBLogSite *site = JBLogSites::first(); site != nullptr; site = site->next) {
+		before++;
+	}
+
+	static std::atomic<bool> started(false);
+	std::vector<std::thread> workers;
+	for (int t = 0; t < threads; t++) {
+		workers.emplace_back([t]() {
+			while (!started) {
+			}
+			for (int i = 0; i < ownSites; i++) {
+				JBLogSites::add(sites[t * ownSites + i]);
+				JBLogSite &shared = sites[threads * ownSites + i % sharedSites];
+				if (shared.mode == JBLOG_SITE_NEW) {
+					JBLogSites::add(shared);
+				}
+			}
+		});
+	}
+	started = true;
+	for (std::thread &worker : workers) {
+		worker.join();
+	}
+
+	size_t count = 0;
+	for (const JBLogSite *site = JBLogSites::first(); site != nullptr; site = site->next) {
+		count++;
+	}
+	check(count - before == sites.size(), "concurrent sites are all added once",
+		  std::to_string(count - before) + " sites added");
+}
+
+/// @brief Sink base with a pure virtual write, like Client
+class AbstractSink {
+public:
+	virtual ~AbstractSink() = default;
+	virtual size_t write(const uint8_t *buffer, size_t size) = 0;
+};
+
+/// @brief Sink base with a virtual write, like HardwareSerial
+class BaseSink : public AbstractSink {
+public:
+	size_t write(const uint8_t *, size_t size) override {
+		return size;
+	}
+};
+
+/// @brief Sink overriding the write of its base, like WiFiClient
+class DerivedSink : public BaseSink {
+public:
+	size_t write(const uint8_t *buffer, size_t size) override {
+		output.append(reinterpret_cast<const char *>(buffer), size);
+		return size;
+	}
+	std::string output;
+};
+
+/// @brief A logger for a polymorphic sink type writes through the actual sink object
+static void checkPolymorphicSinks() {
+	DerivedSink sink;
+	JBBasicLogger<AbstractSink> abstractLogger("LOG", LOG_LEVEL_INFO, sink, true, true, false);
+	abstractLogger.info("abstract");
+	check(sink.output == "I LOG: abstract\r\n", "abstract sink type writes to the derived sink", sink.output);
+
+	sink.output.clear();
+	JBBasicLogger<BaseSink> baseLogger("LOG", LOG_LEVEL_INFO, sink, true, true, false);
+	baseLogger.info("base");
+	check(sink.output == "I LOG: base\r\n", "base sink type writes to the derived sink", sink.output);
+}
+
+int main() {
+	checkLongMessages();
+	checkLongPrefix();
+	checkLogLineValues();
+#ifdef JBLOGGER_HAS_JBFMT
+	checkJBFMT();
+#endif
+	checkSites();
+	checkSiteCommands();
+	checkConcurrentSites();
+	checkPolymorphicSinks();
+
+	if (failures > 0) {
+		fprintf(stderr, "%d checks failed\n", failures);
+		return 1;
+	}
+	printf("All checks passed\n");
+	return 0;
+}
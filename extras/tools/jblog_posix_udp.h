@@ -0,0 +1,130 @@
+/// @file jblog_posix_udp.h
+/// @author Jonny Bergdahl
+/// @brief Arduino UDP on POSIX sockets, for host builds
+/// @date Created: 2026-10-18
+/// @details This file contains PosixUDP, an implementation of the Arduino UDP interface of
+/// extras/host/Udp.h on a POSIX socket, so JBSyslogStream can be tested on a desktop host.
+/// Only sending is implemented. Sending can be made to fail, to simulate a network outage.
+///
+/// You can find the source code and/ collaborate on
+/// [https://github.com/jonnybergdahl/Bergdahl_JBLogger](https://github.com/jonnybergdahl/Bergdahl_JBLogger).
+///
+/// This code is distributed under the MIT License. See the LICENSE file for details.
+#ifndef JBLOG_POSIX_UDP_H
+#define JBLOG_POSIX_UDP_H
+
+#include <Udp.h>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+/// @brief Arduino UDP on a POSIX socket, send only
+class PosixUDP : public UDP {
+public:
+	~PosixUDP() override {
+		stop();
+	}
+
+	/// @brief Opens the socket, the port is not used as nothing is received
+	uint8_t begin(uint16_t) override {
+		stop();
+		_socket = socket(AF_INET, SOCK_DGRAM, 0);
+		return _socket >= 0 ? 1 : 0;
+	}
+
+	void stop() override {
+		if (_socket >= 0) {
+			close(_socket);
+			_socket = -1;
+		}
+	}
+
+	int beginPacket(IPAddress ip, uint16_t port) override {
+		if (_socket < 0 || _failing) {
+			return 0;
+		}
+		memset(&_to, 0, sizeof(_to));
+		_to.sin_family = AF_INET;
+		_to.sin_port = htons(port);
+		_to.sin_addr.s_addr = htonl(static_cast<uint32_t>(ip[0]) << 24 | static_cast<uint32_t>(ip[1]) << 16 |
+									static_cast<uint32_t>(ip[2]) << 8 | ip[3]);
+		_length = 0;
+		return 1;
+	}
+
+	int beginPacket(const char *host, uint16_t port) override {
+		IPAddress address;
+		return resolve(host, address) ? beginPacket(address, port) : 0;
+	}
+
+	int endPacket() override {
+		if (sendto(_socket, _packet, _length, 0, reinterpret_cast<const sockaddr *>(&_to), sizeof(_to)) !=
+			static_cast<ssize_t>(_length)) {
+			return 0;
+		}
+		_packets++;
+		return 1;
+	}
+
+	int parsePacket() override {
+		return 0;
+	}
+
+	size_t write(uint8_t value) override {
+		return write(&value, 1);
+	}
+
+	size_t write(const uint8_t *buffer, size_t size) override {
+		if (size > sizeof(_packet) - _length) {
+			size = sizeof(_packet) - _length;
+		}
+		memcpy(_packet + _length, buffer, size);
+		_length += size;
+		return size;
+	}
+
+	using Print::write;
+
+	int available() override { return 0; }
+	int read() override { return -1; }
+	int peek() override { return -1; }
+
+	/// @brief Makes beginPacket() fail, as when the network is down
+	void setFailing(bool value) {
+		_failing = value;
+	}
+
+	/// @brief Returns the number of datagrams sent
+	unsigned long getPackets() const {
+		return _packets;
+	}
+
+	/// @brief Resolves an IPv4 host name, usable as a JBSyslogResolver
+	static bool resolve(const char *host, IPAddress &address) {
+		addrinfo hints;
+		memset(&hints, 0, sizeof(hints));
+		hints.ai_family = AF_INET;
+		hints.ai_socktype = SOCK_DGRAM;
+		addrinfo *result = nullptr;
+		if (getaddrinfo(host, nullptr, &hints, &result) != 0 || result == nullptr) {
+			return false;
+		}
+		const uint32_t ip = ntohl(reinterpret_cast<const sockaddr_in *>(result->ai_addr)->sin_addr.s_addr);
+		freeaddrinfo(result);
+		address = IPAddress(ip >> 24, (ip >> 16) & 0xff, (ip >> 8) & 0xff, ip & 0xff);
+		return true;
+	}
+
+private:
+	int _socket = -1;								///< Socket, or -1
+	sockaddr_in _to;								///< Destination of the packet
+	uint8_t _packet[65507];							///< Packet being written
+	size_t _length = 0;								///< Length of _packet
+	bool _failing = false;							///< True if beginPacket() fails
+	unsigned long _packets = 0;						///< Datagrams sent
+};
+
+#endif // JBLOG_POSIX_UDP_H
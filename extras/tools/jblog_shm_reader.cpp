@@ -0,0 +1,298 @@
+/// @file jblog_shm_reader.cpp
+/// @author Jonny Bergdahl
+/// @brief Host tool reading logs written by JBShmSink
+/// @date Created: 2026-10-18
+/// @details Maps a shared memory log ring read only and writes its log lines to stdout.
+///
+/// Build with: c++ -std=c++14 -O2 -o jblog_shm_reader jblog_shm_reader.cpp
+///
+/// Usage: jblog_shm_reader [-f] [-t] name
+///
+/// The name is the one given to the JBShmSink, or a path to the ring file. All records in
+/// the ring are written, from the oldest one. Use -t to skip the records already in the
+/// ring, and -f to keep following the ring as records are added, like tail -f. The reader
+/// never blocks the writer. Records the writer overwrites before they are read are skipped,
+/// and reported on stderr. A ring left by a crashed process can be read as usual, unless it
+/// stopped in the middle of a write after the ring wrapped, then the records before the head
+/// are skipped. With -f the reader waits for the ring to be created.
+///
+/// You can find the source code and/ collaborate on
+/// [https://github.com/jonnybergdahl/Bergdahl_JBLogger](https://github.com/jonnybergdahl/Bergdahl_JBLogger).
+///
+/// This code is distributed under the MIT License. See the LICENSE file for details.
+#include "../../src/jblogger_shm_format.h"
+#include <fcntl.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
+
+#define OUTPUT_SIZE (256 * 1024)		///< Size of the output batch
+#define STALE_RETRIES 50				///< Retries, 1 ms apart, before a stale oldest is given up
+
+static volatile sig_atomic_t stopped = 0;
+
+static void onSignal(int) {
+	stopped = 1;
+}
+
+/// @brief A mapped ring
+class Ring {
+public:
+	~Ring() {
+		close();
+	}
+
+	/// @brief Maps the ring file read only, keeps the current ring if it fails
+	bool open(const char *path) {
+		const int handle = ::open(path, O_RDONLY | O_CLOEXEC);
+		if (handle < 0) {
+			return false;
+		}
+		struct stat status;
+		if (fstat(handle, &status) != 0 || static_cast<size_t>(status.st_size) < sizeof(JBShmHeader)) {
+			::close(handle);
+			return false;
+		}
+		const size_t size = static_cast<size_t>(status.st_size);
+		void *memory = mmap(nullptr, size, PROT_READ, MAP_SHARED, handle, 0);
+		::close(handle);
+		if (memory == MAP_FAILED) {
+			return false;
+		}
+		const auto *header = static_cast<const JBShmHeader *>(memory);
+		const uint32_t capacity = header->capacity;
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (header->magic != JBLOGGER_SHM_MAGIC || header->version != JBLOGGER_SHM_VERSION ||
+			capacity < 4096 || (capacity & (capacity - 1)) != 0 || sizeof(JBShmHeader) + capacity != size) {
+			munmap(memory, size);
+			return false;
+		}
+		close();
+		_header = header;
+		_data = reinterpret_cast<const uint8_t *>(header) + sizeof(JBShmHeader);
+		_size = size;
+		_capacity = capacity;
+		_inode = status.st_ino;
+		return true;
+	}
+
+	void close() {
+		if (_header != nullptr) {
+			munmap(const_cast<JBShmHeader *>(_header), _size);
+			_header = nullptr;
+		}
+	}
+
+	/// @brief Returns true if the path now names another file, the writer replaced the ring
+	bool replaced(const char *path) const {
+		struct stat status;
+		return stat(path, &status) == 0 && status.st_ino != _inode;
+	}
+
+	const JBShmHeader *header() const {
+		return _header;
+	}
+
+	uint32_t capacity() const {
+		return _capacity;
+	}
+
+	/// @brief Reads the record header at a position
+	JBShmRecord record(uint64_t position) const {
+		JBShmRecord record;
+		memcpy(&record, _data + (position & (_capacity - 1)), sizeof(record));
+		return record;
+	}
+
+	/// @brief Returns the text of the record at a position, in the mapped ring
+	const char *text(uint64_t position) const {
+		return reinterpret_cast<const char *>(_data + (position & (_capacity - 1)) + sizeof(JBShmRecord));
+	}
+
+private:
+	const JBShmHeader *_header = nullptr;
+	const uint8_t *_data = nullptr;
+	size_t _size = 0;
+	uint32_t _capacity = 0;
+	ino_t _inode = 0;
+};
+
+/// @brief Follows a ring and writes the records to stdout
+class Reader {
+public:
+	explicit Reader(const Ring &ring) : _ring(ring) {}
+
+	/// @brief Starts at the oldest record, or at the head
+	void start(bool tail) {
+		// Room for at least the largest record
+		_output.resize(OUTPUT_SIZE > _ring.capacity() / 2 ? OUTPUT_SIZE : _ring.capacity() / 2);
+		_position = tail ? _ring.header()->head.load(std::memory_order_acquire)
+						 : _ring.header()->oldest.load(std::memory_order_acquire);
+		_synced = false;
+	}
+
+	/// @brief Reads a batch of the records added since the last call
+	/// @return False when there is nothing more to read
+	bool poll() {
+		const uint64_t head = _ring.header()->head.load(std::memory_order_acquire);
+		const uint32_t capacity = _ring.capacity();
+		const uint64_t start = _position;
+		uint64_t position = _position;
+		size_t length = 0;
+		size_t count = 0;
+		uint32_t firstSequence = 0;
+		uint32_t lastSequence = 0;
+		bool corrupt = false;
+
+		// Copy a batch of records, the copy is validated afterwards, seqlock style
+		while (position < head) {
+			const JBShmRecord record = _ring.record(position);
+			if (record.length == JBLOGGER_SHM_PADDING) {
+				position += capacity - (position & (capacity - 1));
+				continue;
+			}
+			const uint64_t size = JBShmRecordSize(record.length);
+			if (record.length > capacity / 2 || size > capacity - (position & (capacity - 1))) {
+				corrupt = true;
+				break;
+			}
+			if (length + record.length > _output.size()) {
+				break;
+			}
+			length += copyText(_ring.text(position), record.length, _output.data() + length);
+			if (count++ == 0) {
+				firstSequence = record.sequence;
+			}
+			lastSequence = record.sequence;
+			position += size;
+		}
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+		const uint64_t reserved = _ring.header()->reserved.load(std::memory_order_relaxed);
+		if (reserved > capacity && start < reserved - capacity) {
+			// The writer overwrote the records while they were copied, start over at the oldest one
+			const uint64_t oldest = _ring.header()->oldest.load(std::memory_order_acquire);
+			if (oldest >= reserved - capacity) {
+				_position = oldest;
+				_stale = 0;
+				return true;
+			}
+			// The writer has not stored oldest yet, if it stopped in the middle of a write it
+			// never will, and the records before the head can not be told from overwritten ones
+			if (++_stale < STALE_RETRIES) {
+				const struct timespec pause = { 0, 1000 * 1000 };
+				nanosleep(&pause, nullptr);
+				_position = oldest;
+				return true;
+			}
+			fprintf(stderr, "jblog_shm_reader: writer stopped during a write, skipping to the head\n");
+			_position = head;
+			_stale = 0;
+			return false;
+		}
+		_stale = 0;
+		if (corrupt && count == 0) {
+			fprintf(stderr, "jblog_shm_reader: corrupt record, skipping to the head\n");
+			_position = head;
+			return false;
+		}
+
+		if (count > 0) {
+			if (_synced && firstSequence != _sequence + 1) {
+				fprintf(stderr, "jblog_shm_reader: %lu records lost\n",
+						static_cast<unsigned long>(firstSequence - _sequence - 1));
+			}
+			_synced = true;
+			_sequence = lastSequence;
+			fwrite(_output.data(), 1, length, stdout);
+		}
+		_position = position;
+		return position < head;
+	}
+
+private:
+	const Ring &_ring;
+	std::vector<char> _output;
+	uint64_t _position = 0;
+	uint32_t _sequence = 0;
+	bool _synced = false;
+	int _stale = 0;								///< Retries with an oldest below the valid records
+
+	/// @brief Copies the text of a record, with "\r\n" line ends written as "\n"
+	static size_t copyText(const char *text, uint32_t length, char *output) {
+		size_t count = 0;
+		for (uint32_t i = 0; i < length; i++) {
+			if (text[i] != '\r' || i + 1 >= length || text[i + 1] != '\n') {
+				output[count++] = text[i];
+			}
+		}
+		return count;
+	}
+};
+
+int main(int argc, char **argv) {
+	bool follow = false;
+	bool tail = false;
+	int arg = 1;
+	for (; arg < argc && argv[arg][0] == '-' && argv[arg][1] != '\0' && argv[arg][2] == '\0'; arg++) {
+		if (argv[arg][1] == 'f') {
+			follow = true;
+		} else if (argv[arg][1] == 't') {
+			tail = true;
+		} else {
+			break;
+		}
+	}
+	if (argc - arg != 1 || argv[arg][0] == '-') {
+		fprintf(stderr, "Usage: %s [-f] [-t] name\n", argv[0]);
+		return 2;
+	}
+	const std::string path = strchr(argv[arg], '/') != nullptr ? argv[arg] : std::string("/dev/shm/") + argv[arg];
+
+	struct sigaction action;
+	memset(&action, 0, sizeof(action));
+	action.sa_handler = onSignal;
+	sigaction(SIGINT, &action, nullptr);
+	sigaction(SIGTERM, &action, nullptr);
+
+	const struct timespec idle = { 0, 10 * 1000 * 1000 };
+	Ring ring;
+	while (!ring.open(path.c_str())) {
+		if (!follow) {
+			fprintf(stderr, "jblog_shm_reader: %s is not a log ring\n", path.c_str());
+			return 1;
+		}
+		// Wait for the writer to create the ring
+		if (stopped) {
+			return 0;
+		}
+		nanosleep(&idle, nullptr);
+	}
+	Reader reader(ring);
+	reader.start(tail);
+
+	while (!stopped) {
+		if (reader.poll()) {
+			continue;
+		}
+		if (!follow) {
+			break;
+		}
+		fflush(stdout);
+		if (ring.replaced(path.c_str()) && ring.open(path.c_str())) {
+			fprintf(stderr, "jblog_shm_reader: ring was replaced, reading the new one\n");
+			reader.start(false);
+			continue;
+		}
+		nanosleep(&idle, nullptr);
+	}
+	fflush(stdout);
+	return 0;
+}
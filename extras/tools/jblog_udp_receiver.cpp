@@ -0,0 +1,179 @@
+/// @file jblog_udp_receiver.cpp
+/// @author Jonny Bergdahl
+/// @brief Host tool receiving logs sent by JBSyslogStream
+/// @date Created: 2026-10-18
+/// @details Listens for syslog datagrams on a UDP port, prints the log lines and reports
+/// lost datagrams, using the sequenceId in each datagram.
+///
+/// Build with: c++ -std=c++14 -O2 -o jblog_udp_receiver jblog_udp_receiver.cpp
+///
+/// Usage: jblog_udp_receiver [-q] [port]
+///
+/// The port defaults to 5514, so the tool can run without root. Use -q to only count the
+/// lines. Statistics are written to stderr every second, and when the tool is stopped
+/// with Ctrl-C.
+///
+/// This tool is intended for testing on a POSIX host.
+///
+/// You can find the source code and/ collaborate on
+/// [https://github.com/jonnybergdahl/Bergdahl_JBLogger](https://github.com/jonnybergdahl/Bergdahl_JBLogger).
+///
+/// This code is distributed under the MIT License. See the LICENSE file for details.
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+
+static volatile sig_atomic_t stopped = 0;
+
+/// @brief Receive statistics
+struct Statistics {
+	uint64_t datagrams = 0;		///< Datagrams received
+	uint64_t lines = 0;			///< Log lines received
+	uint64_t bytes = 0;			///< Bytes received
+	uint64_t lost = 0;			///< Datagrams missing in the sequence
+	uint64_t reordered = 0;		///< Datagrams arriving after a later one
+	uint32_t lastSequence = 0;	///< sequenceId of the latest datagram, 0 before the first
+};
+
+static void onSignal(int) {
+	stopped = 1;
+}
+
+static double now() {
+	struct timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return static_cast<double>(time.tv_sec) + static_cast<double>(time.tv_nsec) / 1e9;
+}
+
+/// @brief Returns the sequenceId of a datagram, or 0 if it has none
+static uint32_t parseSequence(const char *data) {
+	const char *sequence = strstr(data, "sequenceId=\"");
+	return sequence != nullptr ? static_cast<uint32_t>(strtoul(sequence + 12, nullptr, 10)) : 0;
+}
+
+/// @brief Returns the start of the message, after the syslog header and structured data
+static const char *findMessage(const char *data) {
+	const char *end = strstr(data, "] ");
+	if (end != nullptr) {
+		return end + 2;
+	}
+	// HEADER and "- " structured data: skip seven space separated fields
+	const char *message = data;
+	for (int field = 0; field < 7 && message != nullptr; field++) {
+		message = strchr(message, ' ');
+		message = message != nullptr ? message + 1 : nullptr;
+	}
+	return message != nullptr ? message : data;
+}
+
+static void report(const Statistics &statistics, double elapsed) {
+	fprintf(stderr, "datagrams: %llu, lines: %llu, %.0f lines/s, %.1f KB/s, lost: %llu, reordered: %llu\n",
+			static_cast<unsigned long long>(statistics.datagrams),
+			static_cast<unsigned long long>(statistics.lines),
+			elapsed > 0 ? statistics.lines / elapsed : 0.0,
+			elapsed > 0 ? statistics.bytes / elapsed / 1024 : 0.0,
+			static_cast<unsigned long long>(statistics.lost),
+			static_cast<unsigned long long>(statistics.reordered));
+}
+
+int main(int argc, char **argv) {
+	bool quiet = false;
+	int arg = 1;
+	if (arg < argc && strcmp(argv[arg], "-q") == 0) {
+		quiet = true;
+		arg++;
+	}
+	if (argc - arg > 1 || (arg < argc && argv[arg][0] == '-')) {
+		fprintf(stderr, "Usage: %s [-q] [port]\n", argv[0]);
+		return 2;
+	}
+	const int port = arg < argc ? atoi(argv[arg]) : 5514;
+
+	const int handle = socket(AF_INET, SOCK_DGRAM, 0);
+	if (handle < 0) {
+		perror("socket");
+		return 1;
+	}
+	int bufferSize = 4 * 1024 * 1024;
+	setsockopt(handle, SOL_SOCKET, SO_RCVBUF, &bufferSize, sizeof(bufferSize));
+	struct timeval timeout = { 0, 200000 };
+	setsockopt(handle, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+	struct sockaddr_in address;
+	memset(&address, 0, sizeof(address));
+	address.sin_family = AF_INET;
+	address.sin_addr.s_addr = htonl(INADDR_ANY);
+	address.sin_port = htons(static_cast<uint16_t>(port));
+	if (bind(handle, reinterpret_cast<struct sockaddr *>(&address), sizeof(address)) < 0) {
+		perror("bind");
+		return 1;
+	}
+
+	struct sigaction action;
+	memset(&action, 0, sizeof(action));
+	action.sa_handler = onSignal;
+	sigaction(SIGINT, &action, nullptr);
+	sigaction(SIGTERM, &action, nullptr);
+
+	fprintf(stderr, "jblog_udp_receiver: listening on UDP port %d\n", port);
+	Statistics statistics;
+	double start = 0;
+	double lastReport = now();
+	char data[65536];
+	while (!stopped) {
+		const ssize_t length = recv(handle, data, sizeof(data) - 1, 0);
+		const double time = now();
+		if (length > 0) {
+			data[length] = '\0';
+			if (statistics.datagrams == 0) {
+				start = time;
+			}
+			statistics.datagrams++;
+			statistics.bytes += static_cast<uint64_t>(length);
+
+			const uint32_t sequence = parseSequence(data);
+			if (sequence != 0) {
+				if (statistics.lastSequence == 0 || sequence > statistics.lastSequence) {
+					if (statistics.lastSequence != 0) {
+						statistics.lost += sequence - statistics.lastSequence - 1;
+					}
+					statistics.lastSequence = sequence;
+				} else if (sequence < statistics.lastSequence) {
+					// Either late, or the sender restarted its count
+					statistics.reordered++;
+					if (statistics.lost > 0) {
+						statistics.lost--;
+					}
+				}
+			}
+
+			const char *message = findMessage(data);
+			statistics.lines++;
+			for (const char *c = message; *c != '\0'; c++) {
+				if (*c == '\n') {
+					statistics.lines++;
+				}
+			}
+			if (!quiet) {
+				fputs(message, stdout);
+				fputc('\n', stdout);
+			}
+		}
+		if (time - lastReport >= 1.0 && statistics.datagrams > 0) {
+			lastReport = time;
+			fflush(stdout);
+			report(statistics, time - start);
+		}
+	}
+	report(statistics, now() - start);
+	close(handle);
+	return 0;
+}
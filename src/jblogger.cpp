@@ -12,446 +12,234 @@
 #include <stdarg.h>
 #include <type_traits>
 
-JBLogger::JBLogger(const char *moduleName, LogLevel level, Stream &stream,
-				   bool showLogLevel, bool showModuleName, bool showTimestamp)
-		: _logLevel(level), _output(stream), _moduleName(moduleName),
+template class JBBasicLogger<Stream>;
+
+JBLoggerBase::JBLoggerBase(const char *moduleName, LogLevel level, bool showLogLevel,
+						   bool showModuleName, bool showTimestamp)
+		: _logLevel(level), _moduleName(moduleName),
 		  _showLogLevel(showLogLevel), _showModuleName(showModuleName),
 		  _showTimestamp(showTimestamp) {}
 
-void JBLogger::log(LogLevel logLevel, bool writePrefix, bool writeLinefeed, const char *message, ...) {
-	if (logLevel > _logLevel) {
-		return;
-	}
+JBLogger::JBLogger(const char *moduleName, LogLevel level, Stream &stream,
+				   bool showLogLevel, bool showModuleName, bool showTimestamp)
+		: JBBasicLogger<Stream>(moduleName, level, stream, showLogLevel, showModuleName, showTimestamp) {}
 
-	char buffer[MAX_MESSAGE_LENGTH];
-	va_list args;
-	va_start(args, message);
-	vsnprintf(buffer, sizeof(buffer), message, args);
-	va_end(args);
+void JBLoggerBase::setLogLevel(LogLevel level) {
+	_logLevel = level;
+}
 
-	if (!writePrefix) {
-		_printPrefix(logLevel);
-	}
+LogLevel JBLoggerBase::getLogLevel() {
+	return _logLevel;
+}
 
-	_output.print(buffer);
+void JBLoggerBase::setShowLogLevel(bool value) {
+	_showLogLevel = value;
+}
 
-	if (writeLinefeed) {
-		_output.println();
-	}
+bool JBLoggerBase::getShowLogLevel() const {
+	return _showLogLevel;
 }
 
-#ifdef ENABLE_STD_STRING
-void JBLogger::log(LogLevel logLevel, bool writePrefix, bool writeLinefeed, std::string& message, ...) {
-	va_list args;
-	va_start(args, message);
-	log(logLevel, writePrefix, writeLinefeed, message.c_str(), args);
-	va_end(args);
+void JBLoggerBase::setShowModuleName(bool value) {
+	_showModuleName = value;
 }
-#endif
 
-#ifdef ARDUINO
-void JBLogger::log(LogLevel logLevel, bool writePrefix, bool writeLinefeed, String& message, ...) {
-	va_list args;
-	va_start(args, message);
-	log(logLevel, writePrefix, writeLinefeed, message.c_str(), args);
-	va_end(args);
+bool JBLoggerBase::getShowModuleName() const {
+	return _showModuleName;
 }
 
-void JBLogger::log(LogLevel logLevel, bool writePrefix, bool writeLinefeed, const __FlashStringHelper *message, ...) {
-	if (logLevel > _logLevel) {
-		return;
-	}
+void JBLoggerBase::setShowTimestamp(bool value) {
+	_showTimestamp = value;
+}
 
-	char buffer[MAX_MESSAGE_LENGTH];
-	va_list args;
-	va_start(args, message);
-	PGM_P pointer = reinterpret_cast<PGM_P>(message);
-	vsnprintf_P(buffer, sizeof(buffer), pointer, args);
-	va_end(args);
+bool JBLoggerBase::getShowTimestamp() const {
+	return _showTimestamp;
+}
 
-	if (!writePrefix) {
-		_printPrefix(logLevel);
-	}
-	_output.print(buffer);
-	if (writeLinefeed) {
-		_output.println();
+/// @brief Appends an unsigned value in decimal
+static void appendDecimal(jblogger::FormatBuffer &out, unsigned long value) {
+	char digits[12];
+	size_t count = 0;
+	do {
+		digits[count++] = static_cast<char>('0' + value % 10);
+		value /= 10;
+	} while (value != 0);
+	while (count > 0) {
+		out.append(digits[--count]);
 	}
 }
-#endif
 
-void JBLogger::traceDump(const void* buffer, uint32_t size) {
-	char hexValue[10];
-	const auto* pointer = static_cast<const uint8_t*>(buffer);
-
-	if (LogLevel::LOG_LEVEL_TRACE > _logLevel) {
-		return;
+/// @brief Appends an unsigned value in hex, zero padded to a minimum number of digits
+static void appendHex(jblogger::FormatBuffer &out, uint32_t value, size_t minDigits, bool upperCase = false) {
+	const char *hexDigits = upperCase ? "0123456789ABCDEF" : "0123456789abcdef";
+	char digits[8];
+	size_t count = 0;
+	do {
+		digits[count++] = hexDigits[value & 0x0f];
+		value >>= 4;
+	} while (value != 0);
+	for (; minDigits > count; minDigits--) {
+		out.append('0');
 	}
-
-	if (size == 0) {
-		_printPrefix(LogLevel::LOG_LEVEL_TRACE);
-		_output.println("0000: (null)");
-		return;
-	}
-
-	for (uint32_t i = 0; i < size; i += 16) {
-		_printPrefix(LogLevel::LOG_LEVEL_TRACE);
-
-		// Print index
-		snprintf(hexValue, 10, "%04x: ", i);
-		_output.print(hexValue);
-		_output.print(' ');
-
-		// Print hex values
-		for (uint32_t j = 0; j < 16; j++) {
-			if (i + j < size) {
-				snprintf(hexValue, 10, "%02x ", pointer[i + j]);
-				_output.print(hexValue);
-			} else {
-				_output.print("   ");
-			}
-		}
-		_output.print(" ");
-		// Print ASCII values
-		for (uint32_t j = 0; j < 16; j++) {
-			if (i + j < size) {
-				char c = static_cast<char>(pointer[i + j]);
-				if (!isprint(c)) {
-					c = '.';
-				}
-				_output.print(c);
-			} else {
-				_output.print(' ');
-			}
-		}
-		_output.println();
+	while (count > 0) {
+		out.append(digits[--count]);
 	}
 }
 
-void JBLogger::traceHexDump(const void* buffer, uint32_t size) {
-	char hexValue[10];
-	const auto* pointer = static_cast<const uint8_t*>(buffer);
+/// @brief Appends a C string
+static void appendString(jblogger::FormatBuffer &out, const char *text) {
+	out.append(text, strlen(text));
+}
 
-	if (LogLevel::LOG_LEVEL_TRACE > _logLevel) {
-		return;
-	}
+/// @brief Appends the row index of a memory dump
+static void appendDumpIndex(jblogger::FormatBuffer &out, uint32_t index) {
+	appendHex(out, index, 4);
+	out.append(":  ", 3);
+}
 
-	if (size == 0) {
-		_printPrefix(LogLevel::LOG_LEVEL_TRACE);
-		_output.println("0000: (null)");
-		return;
+void JBLoggerBase::_formatMessage(jblogger::FormatBuffer &out, const char *message, va_list args) {
+	const size_t available = out.available() + 1;
+	const size_t limit = available < MAX_MESSAGE_LENGTH ? available : MAX_MESSAGE_LENGTH;
+	const int written = vsnprintf(out.end(), limit, message, args);
+	if (written > 0) {
+		// written is the untruncated length
+		out.advance(static_cast<size_t>(written) < limit ? static_cast<size_t>(written) : limit - 1);
 	}
+}
 
-	for (uint32_t i = 0; i < size; i += 16) {
-		_printPrefix(LogLevel::LOG_LEVEL_TRACE);
-		// Print index
-		snprintf(hexValue, 10, "%04x: ", i);
-		_output.print(hexValue);
-		_output.print(' ');
-
-		for (uint32_t j = 0; j < 16; j++) {
-			if (i + j < size) {
-				snprintf(hexValue, 10, "%02x ", pointer[i + j]);
-				_output.print(hexValue);
-			}
-		}
-		_output.println();
+#ifdef ARDUINO
+void JBLoggerBase::_formatMessage(jblogger::FormatBuffer &out, const __FlashStringHelper *message, va_list args) {
+	const size_t available = out.available() + 1;
+	const size_t limit = available < MAX_MESSAGE_LENGTH ? available : MAX_MESSAGE_LENGTH;
+	PGM_P pointer = reinterpret_cast<PGM_P>(message);
+	const int written = vsnprintf_P(out.end(), limit, pointer, args);
+	if (written > 0) {
+		// written is the untruncated length
+		out.advance(static_cast<size_t>(written) < limit ? static_cast<size_t>(written) : limit - 1);
 	}
 }
+#endif
 
-void JBLogger::traceAsciiDump(const void* buffer, uint32_t size)
-{
-	const auto* pointer = static_cast<const uint8_t*>(buffer);
-	char hexValue[10];
-	uint32_t columns = 0;
-
-	if (LogLevel::LOG_LEVEL_TRACE > _logLevel) {
-		return;
-	}
+/// @brief Names of the control characters 0x00 - 0x1f, as written by traceAsciiDump()
+static const char *const controlNames[] = {
+	"<NUL>", "<SOH>", "<STX>", "<ETX>", "<EOT>", "<ENQ>", "<ACK>", "<BEL>",
+	"<BS>", "<TAB>", "<LF>", "<VT>", "<FF>", "<CR>", "<SO>", "<SI>",
+	"<DLE>", "<DC1>", "<DC2>", "<DC3>", "<DC4>", "<NAK>", "<SYN>", "<ETB>",
+	"<CAN>", "<EM>", "<SUB>", "<ESC>", "<FS>", "<GS>", "<RS>", "<US>"
+};
 
+uint32_t JBLoggerBase::_formatDumpRow(jblogger::FormatBuffer &out, DumpFormat format,
+									  const uint8_t *buffer, uint32_t offset, uint32_t size) {
 	if (size == 0) {
-		_printPrefix(LogLevel::LOG_LEVEL_TRACE);
-		_output.println("(empty string)");
-		return;
-	}
+		appendString(out, format == DUMP_FORMAT_ASCII ? "(empty string)" : "0000: (null)");
+		return 0;
+	}
+
+	appendDumpIndex(out, offset);
+	switch (format) {
+		case DUMP_FORMAT_MIXED:
+			// Print hex values
+			for (uint32_t j = 0; j < 16; j++) {
+				if (offset + j < size) {
+					appendHex(out, buffer[offset + j], 2);
+					out.append(' ');
+				} else {
+					out.append("   ", 3);
+				}
+			}
+			out.append(' ');
+			// Print ASCII values
+			for (uint32_t j = 0; j < 16; j++) {
+				if (offset + j < size) {
+					out.append(isprint(buffer[offset + j]) ? static_cast<char>(buffer[offset + j]) : '.');
+				} else {
+					out.append(' ');
+				}
+			}
+			return offset + 16;
 
-	for (uint32_t i=0; i < size; i++)
-	{
-		if (columns == 0) {
-			_printPrefix(LogLevel::LOG_LEVEL_TRACE);
-			snprintf(hexValue, 10, "%04x: ", i);
-			_output.print(hexValue);
-			_output.print(' ');
-		}
-		switch (pointer[i])	{
-			case 0x00:
-				_output.print("<NUL>");
-				columns += 5;
-				break;
-			case 0x01:
-				_output.print("<SOH>");
-				columns += 5;
-				break;
-			case 0x02:
-				_output.print("<STX>");
-				columns += 5;
-				break;
-			case 0x03:
-				_output.print("<ETX>");
-				columns += 5;
-				break;
-			case 0x04:
-				_output.print("<EOT>");
-				columns += 5;
-				break;
-			case 0x05:
-				_output.print("<ENQ>");
-				columns += 5;
-				break;
-			case 0x06:
-				_output.print("<ACK>");
-				columns += 5;
-				break;
-			case 0x07:
-				_output.print("<BEL>");
-				columns += 5;
-				break;
-			case 0x08:
-				_output.print("<BS>");
-				columns += 4;
-				break;
-			case 0x09:
-				_output.print("<TAB>");
-				columns += 5;
-				break;
-			case 0x0a:
-				_output.print("<LF>");
-				columns += 4;
-				break;
-			case 0x0b:
-				_output.print("<VT>");
-				columns += 4;
-				break;
-			case 0x0c:
-				_output.print("<FF>");
-				columns += 4;
-				break;
-			case 0x0d:
-				_output.print("<CR>");
-				columns += 4;
-				break;
-			case 0x0e:
-				_output.print("<SO>");
-				columns += 4;
-				break;
-			case 0x0f:
-				_output.print("<SI>");
-				columns += 4;
-				break;
-			case 0x10:
-				_output.print("<DLE>");
-				columns += 5;
-				break;
-			case 0x11:
-				_output.print("<DC1>");
-				columns += 5;
-				break;
-			case 0x12:
-				_output.print("<DC2>");
-				columns += 5;
-				break;
-			case 0x13:
-				_output.print("<DC3>");
-				columns += 5;
-				break;
-			case 0x14:
-				_output.print("<DC4>");
-				columns += 5;
-				break;
-			case 0x15:
-				_output.print("<NAK>");
-				columns += 5;
-				break;
-			case 0x16:
-				_output.print("<SYN>");
-				columns += 5;
-				break;
-			case 0x17:
-				_output.print("<ETB>");
-				columns += 5;
-				break;
-			case 0x18:
-				_output.print("<CAN>");
-				columns += 5;
-				break;
-			case 0x19:
-				_output.print("<EM>");
-				columns += 4;
-				break;
-			case 0x1a:
-				_output.print("<SUB>");
-				columns += 5;
-				break;
-			case 0x1b:
-				_output.print("<ESC>");
-				columns += 5;
-				break;
-			case 0x1c:
-				_output.print("<FS>");
-				columns += 4;
-				break;
-			case 0x1d:
-				_output.print("<GS>");
-				columns += 4;
-				break;
-			case 0x1e:
-				_output.print("<RS>");
-				columns += 4;
-				break;
-			case 0x1f:
-				_output.print("<US>");
-				columns += 4;
-				break;
-			case 0x7f:
-				_output.print("<DEL>");
-				columns += 5;
-				break;
-			case 0xff:
-				_output.print("<NBS>");
-				columns += 5;
-				break;
-			default:
-				if (!isprint(pointer[i]))
-				{
-					_output.print("<0x");
-					_output.print(pointer[i], HEX);
-					_output.print('>');
+		case DUMP_FORMAT_HEX:
+			for (uint32_t j = 0; j < 16 && offset + j < size; j++) {
+				appendHex(out, buffer[offset + j], 2);
+				out.append(' ');
+			}
+			return offset + 16;
+
+		case DUMP_FORMAT_ASCII: {
+			uint32_t columns = 0;
+			uint32_t i = offset;
+			for (; i < size && columns < 64; i++) {
+				const uint8_t c = buffer[i];
+				if (c < 0x20) {
+					appendString(out, controlNames[c]);
+					columns += strlen(controlNames[c]);
+				} else if (c == 0x7f) {
+					out.append("<DEL>", 5);
+					columns += 5;
+				} else if (c == 0xff) {
+					out.append("<NBS>", 5);
+					columns += 5;
+				} else if (!isprint(c)) {
+					out.append("<0x", 3);
+					appendHex(out, c, 2, true);
+					out.append('>');
 					columns += 6;
-				}
-				else
-				{
-					_output.print((char)pointer[i]);
+				} else {
+					out.append(static_cast<char>(c));
 					columns++;
 				}
-				break;
-		}
-
-		if (columns >= 64)
-		{
-			_output.println();
-			columns = 0;
+			}
+			return i;
 		}
-	}
-	_output.println();
-}
-
-void JBLogger::traceBinaryDump(const void *buffer, uint32_t size) {
-	char hexValue[10];
-	const auto* pointer = static_cast<const uint8_t*>(buffer);
-
-	if (LogLevel::LOG_LEVEL_TRACE > _logLevel) {
-		return;
-	}
-
-	if (size == 0) {
-		_printPrefix(LogLevel::LOG_LEVEL_TRACE);
-		_output.println("0000: (null)");
-		return;
-	}
-
-	for (uint32_t i = 0; i < size; i += 4) {
-		_printPrefix(LogLevel::LOG_LEVEL_TRACE);
-		// Print index
-		snprintf(hexValue, 10, "%04x: ", i);
-		_output.print(hexValue);
-		_output.print(' ');
 
-		for (uint32_t j = 0; j < 4; j++) {
-			if (i + j < size) {
-				snprintf(hexValue, 10, "%02x:", pointer[i + j]);
-				_output.print(hexValue);
+		case DUMP_FORMAT_BINARY:
+			for (uint32_t j = 0; j < 4 && offset + j < size; j++) {
+				const uint8_t value = buffer[offset + j];
+				appendHex(out, value, 2);
+				out.append(':');
 				for (int8_t k = 7; k >= 0; --k) {
-					_output.print((pointer[i + j] & (1 << k)) ? '1' : '0');
+					out.append((value & (1 << k)) ? '1' : '0');
 				}
-				_output.print(" ");
+				out.append(' ');
 			}
-		}
-		_output.println();
+			return offset + 4;
 	}
+	return size;
 }
 
-void JBLogger::setOutput(Stream &stream) {
-	_output = stream;
-}
-
-Stream& JBLogger::getOutput() {
-	return _output;
-}
-
-void JBLogger::setLogLevel(LogLevel level) {
-	_logLevel = level;
-}
-
-LogLevel JBLogger::getLogLevel() {
-	return _logLevel;
-}
-
-void JBLogger::setShowLogLevel(bool value) {
-	_showLogLevel = value;
-}
-
-bool JBLogger::getShowLogLevel() const {
-	return _showLogLevel;
-}
-
-void JBLogger::setShowModuleName(bool value) {
-	_showModuleName = value;
-}
-
-bool JBLogger::getShowModuleName() const {
-	return _showModuleName;
-}
-
-void JBLogger::setShowTimestamp(bool value) {
-	_showTimestamp = value;
-}
-
-bool JBLogger::getShowTimestamp() const {
-	return _showTimestamp;
-}
-
-void JBLogger::_printPrefix(LogLevel logLevel) const {
+void JBLoggerBase::_formatPrefix(jblogger::FormatBuffer &out, LogLevel logLevel) const {
 	if (_showTimestamp) {
-		_output.print("(");
-		_output.print(millis());
-		_output.print(") ");
+		out.append('(');
+		appendDecimal(out, millis());
+		out.append(") ", 2);
 	}
 
 	if (_showLogLevel) {
 		switch (logLevel) {
 			case LogLevel::LOG_LEVEL_ERROR:
-				_output.print('E');
+				out.append('E');
 				break;
 			case LogLevel::LOG_LEVEL_WARNING:
-				_output.print('W');
+				out.append('W');
 				break;
 			case LogLevel::LOG_LEVEL_INFO:
-				_output.print('I');
+				out.append('I');
 				break;
 			case LogLevel::LOG_LEVEL_DEBUG:
-				_output.print('D');
+				out.append('D');
 				break;
 			case LogLevel::LOG_LEVEL_TRACE:
-				_output.print('T');
+				out.append('T');
 				break;
 			default:
-				_output.print('?');
+				out.append('?');
 				break;
 		}
-		_output.print(" ");
+		out.append(' ');
 	}
 
 	if (_showModuleName) {
-		_output.print(_moduleName);
-		_output.print(": ");
+		appendString(out, _moduleName);
+		out.append(": ", 2);
 	}
 }
@@ -25,6 +25,12 @@
 
 #define JBLOGGER_VERSION "1.0.5"	///< Version of the library
 #define MAX_MESSAGE_LENGTH 128		///< Maximum length of a formatted log message
+#define MAX_PREFIX_LENGTH 48		///< Room for the "(timestamp) log_level module_name: " prefix
+#define MAX_LINE_LENGTH (MAX_PREFIX_LENGTH + MAX_MESSAGE_LENGTH)	///< Maximum length of a log line
+
+#include "jblogger_format.h"
+#include "jblogger_sink.h"
+#include "jblogger_sites.h"
 
 /// @brief Log levels
 enum LogLevel {
@@ -36,26 +42,156 @@ enum LogLevel {
 	LOG_LEVEL_TRACE					///< Trace logging
 };
 
-/// @brief Logging class
+/// @brief Logger settings and line formatting shared by all sinks
+/// @details This class holds the settings of a logger and formats the parts of a log line.
+/// It does not write any output, that is done by JBBasicLogger.
+///
+class JBLoggerBase {
+public:
+	/// @brief Sets the minimum log level for messages to be logged.
+	///
+	/// This function allows you to specify the minimum log level for messages to be logged.
+	/// Messages with a log level equal to or higher than the specified level will be logged,
+	/// while messages with lower log levels will be ignored.
+	///
+	/// @param level The minimum log level to be logged.
+	///
+	void setLogLevel(LogLevel level);
+
+	/// @brief Returns the minimum log level for messages to be logged.
+	/// @return The minimum log level for messages to be logged.
+	LogLevel getLogLevel();
+
+	/// @brief Specifies whether the log level should be displayed in log messages.
+	///
+	/// This function allows you to control whether the log level should be included in the
+	/// log messages. If set to `true`, the log level will be displayed in log messages.
+	/// If set to `false`, the log level will not be included in the log messages.
+	///
+	/// @param value A boolean value indicating whether to show the log level in log messages.
+	///
+	void setShowLogLevel(bool value);
+
+	/// @brief Returns whether the log level should be displayed in log messages.
+	/// @return A boolean value indicating whether the log level should be displayed in log messages.
+	bool getShowLogLevel() const;
+
+	/// @brief Specifies whether the module name should be displayed in log messages.
+	///
+	/// This function allows you to control whether the module name should be included in
+	/// the log messages. If set to `true`, the module name will be displayed in log messages.
+	/// If set to `false`, the module name will not be included in the log messages.
+	///
+	/// @param value A boolean value indicating whether to show the module name in log messages.
+	///
+	void setShowModuleName(bool value);
+
+	/// @brief Returns whether the module name should be displayed in log messages.
+	/// @return A boolean value indicating whether the module name should be displayed in log messages.
+	bool getShowModuleName() const;
+
+	/// Set whether to display timestamps in log messages.
+	///
+	/// @brief Specifies whether timestamps should be displayed in log messages.
+	///
+	/// This function allows you to control whether timestamps should be included in the log
+	/// messages. If set to `true`, timestamps will be displayed in log messages to indicate
+	/// when each log entry was generated. If set to `false`, timestamps will not be included
+	/// in the log messages.
+	///
+	/// @param value A boolean value indicating whether to show timestamps in log messages.
+	///
+	void setShowTimestamp(bool value);
+
+	/// @brief Returns whether timestamps should be displayed in log messages.
+	/// @return A boolean value indicating whether timestamps should be displayed in log messages.
+	bool getShowTimestamp() const;
+
+protected:
+	/// @brief Memory dump formats
+	enum DumpFormat : uint8_t {
+		DUMP_FORMAT_MIXED,				///< Hex and ASCII, as written by traceDump()
+		DUMP_FORMAT_HEX,				///< Hex, as written by traceHexDump()
+		DUMP_FORMAT_ASCII,				///< ASCII, as written by traceAsciiDump()
+		DUMP_FORMAT_BINARY				///< Binary, as written by traceBinaryDump()
+	};
+
+	/// @brief Constructor
+	/// @param moduleName Module name
+	/// @param level Log level
+	/// @param showLogLevel Show log level in log message
+	/// @param showModuleName Show module name in log message
+	/// @param showTimestamp Show timestamp in log message
+	///
+	JBLoggerBase(const char *moduleName, LogLevel level, bool showLogLevel,
+				 bool showModuleName, bool showTimestamp);
+
+	/// @brief Formats the logging prefix
+	/// @param out Buffer to append to
+	/// @param logLevel Log level
+	void _formatPrefix(jblogger::FormatBuffer &out, LogLevel logLevel) const;
+
+	/// @brief Formats a message using vsnprintf, limited to MAX_MESSAGE_LENGTH
+	/// @param out Buffer to append to
+	/// @param message The format string
+	/// @param args Arguments to be formatted according to the format string
+	static void _formatMessage(jblogger::FormatBuffer &out, const char *message, va_list args);
+
+#ifdef ARDUINO
+	/// @brief Formats a message stored in flash using vsnprintf_P, limited to MAX_MESSAGE_LENGTH
+	/// @param out Buffer to append to
+	/// @param message The format string
+	/// @param args Arguments to be formatted according to the format string
+	static void _formatMessage(jblogger::FormatBuffer &out, const __FlashStringHelper *message, va_list args);
+#endif
+
+	/// @brief Formats one row of a memory dump, without prefix and linefeed
+	/// @param out Buffer to append to
+	/// @param format Dump format
+	/// @param buffer Memory buffer to dump
+	/// @param offset Offset of the row in the buffer
+	/// @param size Size of the buffer
+	/// @return Offset of the next row
+	static uint32_t _formatDumpRow(jblogger::FormatBuffer &out, DumpFormat format,
+								   const uint8_t *buffer, uint32_t offset, uint32_t size);
+
+	LogLevel _logLevel;							///< Log level
+	const char *_moduleName;					///< Module name
+	bool _showLogLevel = true;					///< Show log level in log message
+	bool _showModuleName = true;				///< Show module name in log message
+	bool _showTimestamp = true;					///< Show timestamp in log message
+};
+
+template<class Sink>
+class JBLogLine;
+
+/// @brief Logging class writing to a sink of a known type
 /// @details This class is used for logging
 ///
 /// Depending on the settings, it will output log messages in the following format:
 ///
 /// (timestamp) log_level module_name: message
 ///
-class JBLogger {
+/// Each line is formatted into a buffer of MAX_LINE_LENGTH bytes and written to the sink in
+/// a single call. When Sink is a concrete type, such as HardwareSerial or JBMemorySink, the
+/// write is done without virtual dispatch, see JBLoggerSinkTraits. JBLogger is the type-erased
+/// variant writing to any Stream.
+///
+/// \tparam Sink The sink type, a class with a `write(const uint8_t* buffer, size_t size)` member.
+///
+template<class Sink>
+class JBBasicLogger : public JBLoggerBase {
 public:
 	/// @brief Constructor
 	/// @param moduleName Module name
-	/// @param level Log level, defaults to LOG_LEVEL_WARNING
-	/// @param stream Stream to log to, defaults to Serial
+	/// @param level Log level
+	/// @param sink Sink to log to
 	/// @param showLogLevel Show log level in log message, defaults to true
 	/// @param showModuleName Show module name in log message, defaults to true
 	/// @param showTimestamp Show timestamp in log message, defaults to true
 	///
-	JBLogger(const char *moduleName, LogLevel level = LogLevel::LOG_LEVEL_WARNING,
-			 Stream &stream = Serial, bool showLogLevel = true,
-			 bool showModuleName = true, bool showTimestamp = true);
+	JBBasicLogger(const char *moduleName, LogLevel level, Sink &sink,
+				  bool showLogLevel = true, bool showModuleName = true, bool showTimestamp = true);
 
 	/// @brief Logs a const char* message with the specified log level.
 	///
@@ -120,6 +256,33 @@ public:
 	void log(LogLevel logLevel, bool writePrefix, bool writeLinefeed, const __FlashStringHelper* message, ...);
 #endif
 
+#ifdef JBLOGGER_HAS_JBFMT
+	/// @brief Logs a compile-time parsed format string with the specified log level.
+	///
+	///  This function logs a message with the given log level, using a format string wrapped
+	///  in JBFMT(). The format string is parsed at compile time, and the number and types of
+	///  the arguments are checked against it, so a mismatch gives a compile error. At runtime
+	///  the precompiled segment list is walked without parsing the format string again.
+	///
+	/// @note std::string and String arguments are rejected, pass them using c_str()
+	/// @tparam Format 			Format string type created by JBFMT().
+	/// @tparam Args 			The types of the arguments.
+	/// @param logLevel 		The log level to use for the message.
+	/// @param writePrefix   	Indicates whether to write the prefix before each message.
+	/// @param writeLinefeed 	Specifies whether to write a line feed after the message.
+	/// @param format  			The format string, created using JBFMT().
+	/// @param args      		Arguments to be formatted according to the format string.
+	///
+	template<class Format, typename... Args>
+	typename std::enable_if<jblogger::IsFormatString<Format>::value>::type
+	log(LogLevel logLevel, bool writePrefix, bool writeLinefeed, Format format, Args... args) {
+		if (logLevel > _logLevel) {
+			return;
+		}
+		_logUnfiltered(logLevel, writePrefix, writeLinefeed, format, args...);
+	}
+#endif
+
 	/// @brief Log a message with the ERROR log level
 	///
 	/// This templated function logs an error message with the specified log level. It allows
@@ -220,6 +383,56 @@ public:
 		log(LogLevel::LOG_LEVEL_TRACE, false, true, message, args...);
 	}
 
+	/// @brief Starts a line with the ERROR log level, built using operator<<
+	///
+	/// The returned JBLogLine collects the values streamed into it, and writes the line when
+	/// it goes out of scope, at the end of the statement:
+	///
+	/// logger.error() << "rssi=" << rssi << " ip=" << ip;
+	///
+	/// @return The line builder
+	JBLogLine<Sink> error();
+
+	/// @brief Starts a line with the WARNING log level, built using operator<<
+	/// @return The line builder
+	JBLogLine<Sink> warning();
+
+	/// @brief Starts a line with the INFO log level, built using operator<<
+	/// @return The line builder
+	JBLogLine<Sink> info();
+
+	/// @brief Starts a line with the DEBUG log level, built using operator<<
+	/// @return The line builder
+	JBLogLine<Sink> debug();
+
+	/// @brief Starts a line with the TRACE log level, built using operator<<
+	/// @return The line builder
+	JBLogLine<Sink> trace();
+
+	/// @brief Logs a message at a call site, used by the JBLOG_DEBUG() and JBLOG_TRACE() macros
+	///
+	/// The first time a site runs it is added to the site list. A site that is turned on
+	/// logs regardless of the log level of the logger, a site that is turned off is skipped
+	/// by the macro, and a default site logs when the log level allows it.
+	///
+	/// \tparam T 				The type of the message parameter.
+	/// \tparam Args 			The types of additional variadic arguments.
+	///
+	/// \param site 			The call site.
+	/// \param logLevel 		The log level to use for the message.
+	/// \param message 			The message, which can be of any type 'T'.
+	/// \param args 			Additional arguments to be formatted alongside the message.
+	///
+	template<class T, typename... Args>
+	void logSite(JBLogSite &site, LogLevel logLevel, T message, Args... args) {
+		if (site.mode == JBLOG_SITE_NEW) {
+			JBLogSites::add(site);
+		}
+		if (site.mode == JBLOG_SITE_ON || (site.mode == JBLOG_SITE_DEFAULT && logLevel <= _logLevel)) {
+			_logUnfiltered(logLevel, false, true, message, args...);
+		}
+	}
+
 	/// @brief Log a hex and ASCII dump of a memory buffer with the TRACE log level
 	///
 	/// This function writes a hexadecimal and ASCII dump of a memory buffer to the log
@@ -263,90 +476,482 @@ public:
 	/// @param size The size (in bytes) of the memory buffer.
 	void traceBinaryDump(const void* buffer, uint32_t size);
 
-	/// @brief Allows you to specify the output stream for logging.
+	/// @brief Allows you to specify the output sink for logging.
 	///
-	/// This function allows you to specify an output stream for logging. The output stream
-	/// should be an instance of a class that inherits from the Stream class. It is used to
-	/// define where the log messages will be sent.
+	/// This function allows you to specify an output sink for logging. For JBLogger the
+	/// sink should be an instance of a class that inherits from the Stream class. It is used
+	/// to define where the log messages will be sent.
 	///
-	/// @param stream A reference to the output stream where log messages will be written.
+	/// @param sink A reference to the output sink where log messages will be written.
 	///
-	void setOutput(Stream &stream);
+	void setOutput(Sink &sink);
 
-	/// @brief Returns the output stream for logging.
-	///	@return A reference to the output stream where log messages will be written.
-	Stream& getOutput();
+	/// @brief Returns the output sink for logging.
+	///	@return A reference to the output sink where log messages will be written.
+	Sink& getOutput();
 
-	/// @brief Sets the minimum log level for messages to be logged.
-	///
-	/// This function allows you to specify the minimum log level for messages to be logged.
-	/// Messages with a log level equal to or higher than the specified level will be logged,
-	/// while messages with lower log levels will be ignored.
-	///
-	/// @param level The minimum log level to be logged.
-	///
-	void setLogLevel(LogLevel level);
+private:
+	friend class JBLogLine<Sink>;
 
-	/// @brief Returns the minimum log level for messages to be logged.
-	/// @return The minimum log level for messages to be logged.
-	LogLevel getLogLevel();
+	Sink *_output;								///< Output sink
 
-	/// @brief Specifies whether the log level should be displayed in log messages.
-	///
-	/// This function allows you to control whether the log level should be included in the
-	/// log messages. If set to `true`, the log level will be displayed in log messages.
-	/// If set to `false`, the log level will not be included in the log messages.
-	///
-	/// @param value A boolean value indicating whether to show the log level in log messages.
-	///
-	void setShowLogLevel(bool value);
+	/// @brief Logs a message formatted using vsnprintf, without checking the log level
+	/// @param logLevel Log level
+	/// @param writePrefix Indicates whether to write the prefix before the message
+	/// @param writeLinefeed Specifies whether to write a line feed after the message
+	/// @param message The format string
+	/// @param args Arguments to be formatted according to the format string
+	void _logv(LogLevel logLevel, bool writePrefix, bool writeLinefeed, const char *message, va_list args);
 
-	/// @brief Returns whether the log level should be displayed in log messages.
-	/// @return A boolean value indicating whether the log level should be displayed in log messages.
-	bool getShowLogLevel() const;
+#ifdef ARDUINO
+	/// @brief Logs a message with a format string in flash, without checking the log level
+	/// @param logLevel Log level
+	/// @param writePrefix Indicates whether to write the prefix before the message
+	/// @param writeLinefeed Specifies whether to write a line feed after the message
+	/// @param message The format string
+	/// @param args Arguments to be formatted according to the format string
+	void _logv(LogLevel logLevel, bool writePrefix, bool writeLinefeed, const __FlashStringHelper *message, va_list args);
+#endif
 
-	/// @brief Specifies whether the module name should be displayed in log messages.
-	///
-	/// This function allows you to control whether the module name should be included in
-	/// the log messages. If set to `true`, the module name will be displayed in log messages.
-	/// If set to `false`, the module name will not be included in the log messages.
-	///
-	/// @param value A boolean value indicating whether to show the module name in log messages.
-	///
-	void setShowModuleName(bool value);
+	/// @brief Logs a message without checking the log level, used by logSite() for sites
+	/// that are turned on. There is one overload for each log() overload.
+	/// @param logLevel Log level
+	/// @param writePrefix Indicates whether to write the prefix before the message
+	/// @param writeLinefeed Specifies whether to write a line feed after the message
+	/// @param message The format string
+	/// @param ... Arguments to be formatted according to the format string
+	void _logUnfiltered(LogLevel logLevel, bool writePrefix, bool writeLinefeed, const char *message, ...);
+#ifdef ENABLE_STD_STRING
+	void _logUnfiltered(LogLevel logLevel, bool writePrefix, bool writeLinefeed, std::string& message, ...);
+#endif
+#ifdef ARDUINO
+	void _logUnfiltered(LogLevel logLevel, bool writePrefix, bool writeLinefeed, String& message, ...);
+	void _logUnfiltered(LogLevel logLevel, bool writePrefix, bool writeLinefeed, const __FlashStringHelper* message, ...);
+#endif
+#ifdef JBLOGGER_HAS_JBFMT
+	template<class Format, typename... Args>
+	typename std::enable_if<jblogger::IsFormatString<Format>::value>::type
+	_logUnfiltered(LogLevel logLevel, bool writePrefix, bool writeLinefeed, Format format, Args... args) {
+		constexpr auto counted = jblogger::parseFormat<1>(Format::data());
+		static_assert(counted.valid, "JBLogger: unsupported conversion in format string");
+		static_assert(counted.argCount == sizeof...(Args), "JBLogger: argument count does not match format string");
+		static constexpr auto spec = jblogger::parseFormat<counted.count>(Format::data());
+		constexpr jblogger::ArgClass classes[] = { jblogger::argClass<Args>()..., jblogger::ArgClass::Unsupported };
+		static_assert(jblogger::argumentsMatch(spec, classes, true), "JBLogger: std::string or String given for %s, use c_str()");
+		static_assert(jblogger::argumentsMatch(spec, classes, false), "JBLogger: argument type does not match format string");
+		(void)format;
 
-	/// @brief Returns whether the module name should be displayed in log messages.
-	/// @return A boolean value indicating whether the module name should be displayed in log messages.
-	bool getShowModuleName() const;
+		char line[MAX_LINE_LENGTH + 2];
+		jblogger::FormatBuffer out(line, MAX_LINE_LENGTH);
+		if (!writePrefix) {
+			_formatPrefix(out, logLevel);
+		}
 
-	/// Set whether to display timestamps in log messages.
-	///
-	/// @brief Specifies whether timestamps should be displayed in log messages.
-	///
-	/// This function allows you to control whether timestamps should be included in the log
-	/// messages. If set to `true`, timestamps will be displayed in log messages to indicate
-	/// when each log entry was generated. If set to `false`, timestamps will not be included
-	/// in the log messages.
-	///
-	/// @param value A boolean value indicating whether to show timestamps in log messages.
-	///
-	void setShowTimestamp(bool value);
+		const size_t available = out.available() + 1;
+		jblogger::FormatBuffer message(out.end(), available < MAX_MESSAGE_LENGTH ? available : MAX_MESSAGE_LENGTH);
+		jblogger::formatSegments(message, Format::data(), spec.segments, spec.segments + spec.count, args...);
+		out.advance(message.length());
 
-	/// @brief Returns whether timestamps should be displayed in log messages.
-	/// @return A boolean value indicating whether timestamps should be displayed in log messages.
-	bool getShowTimestamp() const;
+		_writeLine(line, out.length(), writeLinefeed);
+	}
+#endif
+
+	/// @brief Logs a memory dump with the TRACE log level, one line per row
+	/// @param format Dump format
+	/// @param buffer Memory buffer to dump
+	/// @param size Size of the buffer
+	void _dump(DumpFormat format, const void* buffer, uint32_t size);
+
+	/// @brief Writes a line to the sink in a single call
+	/// @param line Line buffer, with room for two more characters after length
+	/// @param length Length of the line
+	/// @param writeLinefeed Specifies whether to append a line feed
+	void _writeLine(char *line, size_t length, bool writeLinefeed) {
+		if (writeLinefeed) {
+			line[length++] = '\r';
+			line[length++] = '\n';
+		}
+		JBLoggerSinkTraits<Sink>::write(*_output, line, length);
+	}
+};
+
+template<class Sink>
+JBBasicLogger<Sink>::JBBasicLogger(const char *moduleName, LogLevel level, Sink &sink,
+								   bool showLogLevel, bool showModuleName, bool showTimestamp)
+		: JBLoggerBase(moduleName, level, showLogLevel, showModuleName, showTimestamp),
+		  _output(&sink) {}
+
+template<class Sink>
+void JBBasicLogger<Sink>::log(LogLevel logLevel, bool writePrefix, bool writeLinefeed, const char *message, ...) {
+	if (logLevel > _logLevel) {
+		return;
+	}
+
+	va_list args;
+	va_start(args, message);
+	_logv(logLevel, writePrefix, writeLinefeed, message, args);
+	va_end(args);
+}
+
+#ifdef ENABLE_STD_STRING
+template<class Sink>
+void JBBasicLogger<Sink>::log(LogLevel logLevel, bool writePrefix, bool writeLinefeed, std::string& message, ...) {
+	if (logLevel > _logLevel) {
+		return;
+	}
+
+	va_list args;
+	va_start(args, message);
+	_logv(logLevel, writePrefix, writeLinefeed, message.c_str(), args);
+	va_end(args);
+}
+#endif
+
+#ifdef ARDUINO
+template<class Sink>
+void JBBasicLogger<Sink>::log(LogLevel logLevel, bool writePrefix, bool writeLinefeed, String& message, ...) {
+	if (logLevel > _logLevel) {
+		return;
+	}
+
+	va_list args;
+	va_start(args, message);
+	_logv(logLevel, writePrefix, writeLinefeed, message.c_str(), args);
+	va_end(args);
+}
+
+template<class Sink>
+void JBBasicLogger<Sink>::log(LogLevel logLevel, bool writePrefix, bool writeLinefeed, const __FlashStringHelper *message, ...) {
+	if (logLevel > _logLevel) {
+		return;
+	}
+
+	va_list args;
+	va_start(args, message);
+	_logv(logLevel, writePrefix, writeLinefeed, message, args);
+	va_end(args);
+}
+#endif
+
+template<class Sink>
+void JBBasicLogger<Sink>::_logUnfiltered(LogLevel logLevel, bool writePrefix, bool writeLinefeed, const char *message, ...) {
+	va_list args;
+	va_start(args, message);
+	_logv(logLevel, writePrefix, writeLinefeed, message, args);
+	va_end(args);
+}
+
+#ifdef ENABLE_STD_STRING
+template<class Sink>
+void JBBasicLogger<Sink>::_logUnfiltered(LogLevel logLevel, bool writePrefix, bool writeLinefeed, std::string& message, ...) {
+	va_list args;
+	va_start(args, message);
+	_logv(logLevel, writePrefix, writeLinefeed, message.c_str(), args);
+	va_end(args);
+}
+#endif
+
+#ifdef ARDUINO
+template<class Sink>
+void JBBasicLogger<Sink>::_logUnfiltered(LogLevel logLevel, bool writePrefix, bool writeLinefeed, String& message, ...) {
+	va_list args;
+	va_start(args, message);
+	_logv(logLevel, writePrefix, writeLinefeed, message.c_str(), args);
+	va_end(args);
+}
+
+template<class Sink>
+void JBBasicLogger<Sink>::_logUnfiltered(LogLevel logLevel, bool writePrefix, bool writeLinefeed, const __FlashStringHelper *message, ...) {
+	va_list args;
+	va_start(args, message);
+	_logv(logLevel, writePrefix, writeLinefeed, message, args);
+	va_end(args);
+}
+
+template<class Sink>
+void JBBasicLogger<Sink>::_logv(LogLevel logLevel, bool writePrefix, bool writeLinefeed, const __FlashStringHelper *message, va_list args) {
+	char line[MAX_LINE_LENGTH + 2];
+	jblogger::FormatBuffer out(line, MAX_LINE_LENGTH);
+	if (!writePrefix) {
+		_formatPrefix(out, logLevel);
+	}
+	_formatMessage(out, message, args);
+
+	_writeLine(line, out.length(), writeLinefeed);
+}
+#endif
+
+template<class Sink>
+void JBBasicLogger<Sink>::_logv(LogLevel logLevel, bool writePrefix, bool writeLinefeed, const char *message, va_list args) {
+	char line[MAX_LINE_LENGTH + 2];
+	jblogger::FormatBuffer out(line, MAX_LINE_LENGTH);
+	if (!writePrefix) {
+		_formatPrefix(out, logLevel);
+	}
+	_formatMessage(out, message, args);
+
+	_writeLine(line, out.length(), writeLinefeed);
+}
+
+template<class Sink>
+void JBBasicLogger<Sink>::traceDump(const void* buffer, uint32_t size) {
+	_dump(DUMP_FORMAT_MIXED, buffer, size);
+}
+
+template<class Sink>
+void JBBasicLogger<Sink>::traceHexDump(const void* buffer, uint32_t size) {
+	_dump(DUMP_FORMAT_HEX, buffer, size);
+}
+
+template<class Sink>
+void JBBasicLogger<Sink>::traceAsciiDump(const void* buffer, uint32_t size) {
+	_dump(DUMP_FORMAT_ASCII, buffer, size);
+}
+
+template<class Sink>
+void JBBasicLogger<Sink>::traceBinaryDump(const void* buffer, uint32_t size) {
+	_dump(DUMP_FORMAT_BINARY, buffer, size);
+}
+
+template<class Sink>
+void JBBasicLogger<Sink>::_dump(DumpFormat format, const void* buffer, uint32_t size) {
+	if (LogLevel::LOG_LEVEL_TRACE > _logLevel) {
+		return;
+	}
+
+	const auto* pointer = static_cast<const uint8_t*>(buffer);
+	uint32_t offset = 0;
+	do {
+		char line[MAX_LINE_LENGTH + 2];
+		jblogger::FormatBuffer out(line, MAX_LINE_LENGTH);
+		_formatPrefix(out, LogLevel::LOG_LEVEL_TRACE);
+		offset = _formatDumpRow(out, format, pointer, offset, size);
+		_writeLine(line, out.length(), true);
+	} while (offset < size);
+}
+
+template<class Sink>
+void JBBasicLogger<Sink>::setOutput(Sink &sink) {
+	_output = &sink;
+}
+
+template<class Sink>
+Sink& JBBasicLogger<Sink>::getOutput() {
+	return *_output;
+}
+
+/// @brief Builds a log line from values streamed into it
+/// @details A JBLogLine is returned by the JBBasicLogger error(), warning(), info(), debug()
+/// and trace() functions without arguments. The values are appended directly to a line
+/// buffer inside the JBLogLine, on the stack, without heap allocations, and the complete line
+/// is written to the sink in a single call when the JBLogLine is destroyed. When the log level
+/// filters the line nothing is formatted.
+///
+/// Integers are written in decimal, floating point values with two decimals, as Print does,
+/// and pointers in hex. std::string and String are appended from their buffer, also when
+/// given as a temporary. A Printable, such as an IPAddress, prints itself into the line. The
+/// line is cut at MAX_MESSAGE_LENGTH characters after the prefix.
+///
+/// \tparam Sink The sink type of the logger.
+///
+template<class Sink>
+class JBLogLine {
+public:
+	/// @brief Constructor, writes the prefix
+	/// @param logger Logger to write the line to, or nullptr if the line is filtered
+	/// @param logLevel Log level of the line
+	JBLogLine(JBBasicLogger<Sink> *logger, LogLevel logLevel)
+			: _logger(logger), _message(_line, 1) {
+		if (_logger != nullptr) {
+			jblogger::FormatBuffer out(_line, MAX_LINE_LENGTH);
+			_logger->_formatPrefix(out, logLevel);
+			_prefixLength = static_cast<uint16_t>(out.length());
+			const size_t available = out.available() + 1;
+			_message = jblogger::FormatBuffer(out.end(), available < MAX_MESSAGE_LENGTH ? available : MAX_MESSAGE_LENGTH);
+		}
+	}
+
+	/// @brief Move constructor, the line is written by the new JBLogLine only
+	JBLogLine(JBLogLine &&other)
+			: _logger(other._logger), _prefixLength(other._prefixLength), _message(_line, 1) {
+		other._logger = nullptr;
+		if (_logger != nullptr) {
+			memcpy(_line, other._line, _prefixLength + other._message.length());
+			_message = jblogger::FormatBuffer(_line + _prefixLength, other._message.available() + other._message.length() + 1);
+			_message.advance(other._message.length());
+		}
+	}
+
+	JBLogLine(const JBLogLine &) = delete;
+	JBLogLine &operator=(const JBLogLine &) = delete;
+
+	/// @brief Destructor, writes the line
+	~JBLogLine() {
+		if (_logger != nullptr) {
+			_logger->_writeLine(_line, _prefixLength + _message.length(), true);
+		}
+	}
+
+	/// @brief Returns true if the line will be written
+	bool isEnabled() const {
+		return _logger != nullptr;
+	}
+
+	/// @brief Appends a string
+	JBLogLine &operator<<(const char *value) {
+		if (_logger != nullptr) {
+			if (value == nullptr) {
+				value = "(null)";
+			}
+			while (*value != '\0' && _message.available() > 0) {
+				_message.append(*value++);
+			}
+		}
+		return *this;
+	}
+
+	/// @brief Appends a character
+	JBLogLine &operator<<(char value) {
+		if (_logger != nullptr) {
+			_message.append(value);
+		}
+		return *this;
+	}
+
+	/// @brief Appends an integer, bool or enum value in decimal
+	template<typename T>
+	typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value, JBLogLine &>::type
+	operator<<(T value) {
+		if (_logger != nullptr) {
+			typedef typename jblogger::FormatIntegerType<T>::type Integer;
+			typedef typename std::make_unsigned<Integer>::type Unsigned;
+			const auto integer = static_cast<Integer>(value);
+			if (integer < 0) {
+				jblogger::appendInteger(_message, true, static_cast<jblogger::FormatUnsigned<Integer>>(
+						static_cast<Unsigned>(0u - static_cast<Unsigned>(integer))));
+			} else {
+				jblogger::appendInteger(_message, false, static_cast<jblogger::FormatUnsigned<Integer>>(
+						static_cast<Unsigned>(integer)));
+			}
+		}
+		return *this;
+	}
+
+	/// @brief Appends a floating point value with two decimals
+	JBLogLine &operator<<(double value) {
+		if (_logger != nullptr) {
+			jblogger::appendFloating(_message, value, 2);
+		}
+		return *this;
+	}
+
+	/// @brief Appends a pointer in hex
+	JBLogLine &operator<<(const void *value) {
+		if (_logger != nullptr) {
+			jblogger::Segment segment = { 0, 0, 'p', 0, 0, -1 };
+			jblogger::formatPointer(_message, segment, value);
+		}
+		return *this;
+	}
+
+#ifdef ENABLE_STD_STRING
+	/// @brief Appends a std::string, a temporary is not copied
+	JBLogLine &operator<<(const std::string &value) {
+		if (_logger != nullptr) {
+			_message.append(value.data(), value.size());
+		}
+		return *this;
+	}
+#endif
+
+#ifdef ARDUINO
+	/// @brief Appends a String, a temporary is not copied
+	JBLogLine &operator<<(const String &value) {
+		if (_logger != nullptr) {
+			_message.append(value.c_str(), value.length());
+		}
+		return *this;
+	}
+
+	/// @brief Appends a string stored in flash
+	JBLogLine &operator<<(const __FlashStringHelper *value) {
+		if (_logger != nullptr) {
+			PGM_P pointer = reinterpret_cast<PGM_P>(value);
+			char c;
+			while (_message.available() > 0 && (c = static_cast<char>(pgm_read_byte(pointer++))) != '\0') {
+				_message.append(c);
+			}
+		}
+		return *this;
+	}
+
+	/// @brief Appends a Printable, such as an IPAddress, printed directly into the line
+	JBLogLine &operator<<(const Printable &value) {
+		if (_logger != nullptr) {
+			jblogger::FormatPrint print(_message);
+			value.printTo(print);
+		}
+		return *this;
+	}
+#endif
 
 private:
-	LogLevel _logLevel;							///< Log level
-	Stream &_output;							///< Output stream
-	const char *_moduleName;					///< Module name
-	bool _showLogLevel = true;					///< Show log level in log message
-	bool _showModuleName = true;				///< Show module name in log message
-	bool _showTimestamp = true;					///< Show timestamp in log message
+	JBBasicLogger<Sink> *_logger;				///< Logger, nullptr if the line is not written
+	uint16_t _prefixLength = 0;					///< Length of the prefix in _line
+	jblogger::FormatBuffer _message;			///< Message part of _line
+	char _line[MAX_LINE_LENGTH + 2];			///< Line buffer, with room for the linefeed
+};
 
-	/// @brief Print logging prefix
-	/// @param logLevel Log level
-	void _printPrefix(LogLevel logLevel) const;
+template<class Sink>
+JBLogLine<Sink> JBBasicLogger<Sink>::error() {
+	return JBLogLine<Sink>(LogLevel::LOG_LEVEL_ERROR <= _logLevel ? this : nullptr, LogLevel::LOG_LEVEL_ERROR);
+}
+
+template<class Sink>
+JBLogLine<Sink> JBBasicLogger<Sink>::warning() {
+	return JBLogLine<Sink>(LogLevel::LOG_LEVEL_WARNING <= _logLevel ? this : nullptr, LogLevel::LOG_LEVEL_WARNING);
+}
+
+template<class Sink>
+JBLogLine<Sink> JBBasicLogger<Sink>::info() {
+	return JBLogLine<Sink>(LogLevel::LOG_LEVEL_INFO <= _logLevel ? this : nullptr, LogLevel::LOG_LEVEL_INFO);
+}
+
+template<class Sink>
+JBLogLine<Sink> JBBasicLogger<Sink>::debug() {
+	return JBLogLine<Sink>(LogLevel::LOG_LEVEL_DEBUG <= _logLevel ? this : nullptr, LogLevel::LOG_LEVEL_DEBUG);
+}
+
+template<class Sink>
+JBLogLine<Sink> JBBasicLogger<Sink>::trace() {
+	return JBLogLine<Sink>(LogLevel::LOG_LEVEL_TRACE <= _logLevel ? this : nullptr, LogLevel::LOG_LEVEL_TRACE);
+}
+
+extern template class JBBasicLogger<Stream>;
+
+/// @brief Logging class
+/// @details This class is used for logging
+///
+/// Depending on the settings, it will output log messages in the following format:
+///
+/// (timestamp) log_level module_name: message
+///
+/// JBLogger writes to any Stream, and is the type-erased variant of JBBasicLogger. Use
+/// JBBasicLogger with a concrete sink type to avoid the virtual write calls.
+///
+class JBLogger : public JBBasicLogger<Stream> {
+public:
+	/// @brief Constructor
+	/// @param moduleName Module name
+	/// @param level Log level, defaults to LOG_LEVEL_WARNING
+	/// @param stream Stream to log to, defaults to Serial
+	/// @param showLogLevel Show log level in log message, defaults to true
+	/// @param showModuleName Show module name in log message, defaults to true
+	/// @param showTimestamp Show timestamp in log message, defaults to true
+	///
+	JBLogger(const char *moduleName, LogLevel level = LogLevel::LOG_LEVEL_WARNING,
+			 Stream &stream = Serial, bool showLogLevel = true,
+			 bool showModuleName = true, bool showTimestamp = true);
 };
 
 #endif // JBLOGGER_H
@@ -0,0 +1,265 @@
+/// @file jblogger_compress.cpp
+/// @author Jonny Bergdahl
+/// @brief Streaming log compression for JBLogger
+/// @date Created: 2026-10-18
+/// @details This file contains the code for JBCompressStream.
+///
+/// You can find the source code and/ collaborate on
+/// [https://github.com/jonnybergdahl/Bergdahl_JBLogger](https://github.com/jonnybergdahl/Bergdahl_JBLogger).
+///
+/// This code is distributed under the MIT License. See the LICENSE file for details.
+#include "jblogger_compress.h"
+#include <string.h>
+
+/// @brief Timestamp parser states
+enum LineState : uint8_t {
+	LINE_STATE_START,				///< At the start of a line, expecting '('
+	LINE_STATE_DIGITS,				///< Parsing the timestamp digits
+	LINE_STATE_SPACE,				///< After ')', expecting ' '
+	LINE_STATE_TEXT					///< In the rest of the line
+};
+
+JBCompressStream::JBCompressStream(Print &output, const char *const *moduleNames, size_t moduleCount)
+		: _output(output), _lineState(LINE_STATE_START) {
+	// The dictionary uses at most half of the window
+	_fill = static_cast<uint16_t>(JBCompressBuildDictionary(_window, JBLOGGER_COMPRESS_WINDOW_SIZE / 2,
+															 moduleNames, moduleCount));
+	_dictionaryLength = _fill;
+	_dictionaryChecksum = JBCompressChecksum(_window, _dictionaryLength);
+	_position = _fill;
+}
+
+size_t JBCompressStream::write(uint8_t value) {
+	if (!_headerWritten) {
+		_writeHeader();
+	}
+	_bytesIn++;
+	_parse(value);
+	return 1;
+}
+
+size_t JBCompressStream::write(const uint8_t *buffer, size_t size) {
+	if (!_headerWritten) {
+		_writeHeader();
+	}
+	_bytesIn += size;
+	for (size_t i = 0; i < size; i++) {
+		_parse(buffer[i]);
+	}
+	return size;
+}
+
+void JBCompressStream::flush() {
+	if (!_headerWritten) {
+		_writeHeader();
+	}
+	if (_pendingLength > 0) {
+		// A partial timestamp is written as text, at a line start the next line keeps its timestamp coding
+		_abortTimestamp();
+	}
+	_compress(true);
+
+	// Sync marker, then pad to a byte boundary
+	_writeBits(0, 1);
+	_writeBits(0, JBLOGGER_COMPRESS_WINDOW_BITS);
+	_writeBits(0, JBLOGGER_COMPRESS_LENGTH_BITS);
+	if (_bitCount > 0) {
+		_writeBits(0, 8 - _bitCount);
+	}
+	_flushOutput();
+	_output.flush();
+}
+
+int JBCompressStream::available() {
+	return 0;
+}
+
+int JBCompressStream::read() {
+	return -1;
+}
+
+int JBCompressStream::peek() {
+	return -1;
+}
+
+uint32_t JBCompressStream::getBytesIn() const {
+	return _bytesIn;
+}
+
+uint32_t JBCompressStream::getBytesOut() const {
+	return _bytesOut + _outLength;
+}
+
+void JBCompressStream::_parse(uint8_t value) {
+	switch (_lineState) {
+		case LINE_STATE_START:
+			if (value == '(') {
+				_pending[0] = '(';
+				_pendingLength = 1;
+				_timestamp = 0;
+				_lineState = LINE_STATE_DIGITS;
+				return;
+			}
+			break;
+
+		case LINE_STATE_DIGITS:
+			if (value >= '0' && value <= '9') {
+				const uint8_t digit = value - '0';
+				// Leading zeros and values above 32 bits would not survive the round trip
+				const bool leadingZero = _pendingLength == 2 && _timestamp == 0;
+				if (!leadingZero && _pendingLength <= 10 && _timestamp <= (0xffffffffUL - digit) / 10) {
+					_timestamp = _timestamp * 10 + digit;
+					_pending[_pendingLength++] = static_cast<char>(value);
+					return;
+				}
+			} else if (value == ')' && _pendingLength > 1) {
+				_pending[_pendingLength++] = ')';
+				_lineState = LINE_STATE_SPACE;
+				return;
+			}
+			_abortTimestamp();
+			break;
+
+		case LINE_STATE_SPACE:
+			if (value == ' ') {
+				uint32_t delta = _timestamp - _lastTimestamp;
+				_lastTimestamp = _timestamp;
+				_pendingLength = 0;
+				_push(JBLOGGER_COMPRESS_TIMESTAMP);
+				while (delta >= 0x80) {
+					_push(static_cast<uint8_t>(delta | 0x80));
+					delta >>= 7;
+				}
+				_push(static_cast<uint8_t>(delta));
+				_lineState = LINE_STATE_TEXT;
+				return;
+			}
+			_abortTimestamp();
+			break;
+
+		default:
+			break;
+	}
+
+	_text(value);
+	_lineState = value == '\n' ? LINE_STATE_START : LINE_STATE_TEXT;
+}
+
+void JBCompressStream::_abortTimestamp() {
+	for (uint8_t i = 0; i < _pendingLength; i++) {
+		_text(static_cast<uint8_t>(_pending[i]));
+	}
+	_pendingLength = 0;
+	_lineState = LINE_STATE_TEXT;
+}
+
+void JBCompressStream::_text(uint8_t value) {
+	if (value == JBLOGGER_COMPRESS_TIMESTAMP || value == JBLOGGER_COMPRESS_ESCAPE) {
+		_push(JBLOGGER_COMPRESS_ESCAPE);
+	}
+	_push(value);
+}
+
+void JBCompressStream::_push(uint8_t value) {
+	if (_fill == sizeof(_window)) {
+		_compress(false);
+		// Keep one window of history
+		const uint16_t shift = _position - JBLOGGER_COMPRESS_WINDOW_SIZE;
+		memmove(_window, _window + shift, _fill - shift);
+		_position -= shift;
+		_fill -= shift;
+	}
+	_window[_fill++] = value;
+	if (_fill - _position >= JBLOGGER_COMPRESS_MAX_MATCH + JBLOGGER_COMPRESS_MAX_MATCH) {
+		_compress(false);
+	}
+}
+
+void JBCompressStream::_compress(bool final) {
+	const uint16_t keep = final ? 0 : JBLOGGER_COMPRESS_MAX_MATCH;
+	while (_fill - _position > keep) {
+		uint16_t maxLength = _fill - _position;
+		if (maxLength > JBLOGGER_COMPRESS_MAX_MATCH) {
+			maxLength = JBLOGGER_COMPRESS_MAX_MATCH;
+		}
+
+		// Find the longest match in the window, searching from the nearest position
+		const uint8_t *current = _window + _position;
+		const uint16_t start = _position > JBLOGGER_COMPRESS_WINDOW_SIZE ? _position - JBLOGGER_COMPRESS_WINDOW_SIZE : 0;
+		uint16_t bestLength = 0;
+		uint16_t bestDistance = 0;
+		if (maxLength >= JBLOGGER_COMPRESS_MIN_MATCH) {
+			for (uint16_t candidate = _position; candidate-- > start; ) {
+				const uint8_t *match = _window + candidate;
+				if (match[0] != current[0] || match[bestLength] != current[bestLength]) {
+					continue;
+				}
+				uint16_t length = 1;
+				while (length < maxLength && match[length] == current[length]) {
+					length++;
+				}
+				if (length > bestLength) {
+					bestLength = length;
+					bestDistance = _position - candidate;
+					if (length == maxLength) {
+						break;
+					}
+				}
+			}
+		}
+
+		if (bestLength >= JBLOGGER_COMPRESS_MIN_MATCH) {
+			_writeBits(0, 1);
+			_writeBits(bestDistance - 1, JBLOGGER_COMPRESS_WINDOW_BITS);
+			_writeBits(bestLength - JBLOGGER_COMPRESS_MIN_MATCH + 1, JBLOGGER_COMPRESS_LENGTH_BITS);
+			_position += bestLength;
+		} else {
+			_writeBits(1, 1);
+			_writeBits(*current, 8);
+			_position++;
+		}
+	}
+}
+
+void JBCompressStream::_writeBits(uint16_t value, uint8_t count) {
+	while (count > 0) {
+		count--;
+		_bits = static_cast<uint8_t>((_bits << 1) | ((value >> count) & 1));
+		if (++_bitCount == 8) {
+			_writeByte(_bits);
+			_bits = 0;
+			_bitCount = 0;
+		}
+	}
+}
+
+void JBCompressStream::_writeByte(uint8_t value) {
+	if (_outLength == sizeof(_outBuffer)) {
+		_flushOutput();
+	}
+	_outBuffer[_outLength++] = value;
+}
+
+void JBCompressStream::_flushOutput() {
+	if (_outLength > 0) {
+		_output.write(_outBuffer, _outLength);
+		_bytesOut += _outLength;
+		_outLength = 0;
+	}
+}
+
+void JBCompressStream::_writeHeader() {
+	_headerWritten = true;
+	_output.write(reinterpret_cast<const uint8_t *>(JBLOGGER_COMPRESS_MAGIC), 4);
+	const uint8_t header[] = {
+		JBLOGGER_COMPRESS_VERSION,
+		JBLOGGER_COMPRESS_WINDOW_BITS,
+		JBLOGGER_COMPRESS_LENGTH_BITS,
+		static_cast<uint8_t>(_dictionaryLength & 0xff),
+		static_cast<uint8_t>(_dictionaryLength >> 8),
+		static_cast<uint8_t>(_dictionaryChecksum & 0xff),
+		static_cast<uint8_t>(_dictionaryChecksum >> 8)
+	};
+	_output.write(header, sizeof(header));
+	_bytesOut += JBLOGGER_COMPRESS_HEADER_LENGTH;
+}
@@ -0,0 +1,137 @@
+/// @file jblogger_compress.h
+/// @author Jonny Bergdahl
+/// @brief Streaming log compression for JBLogger
+/// @date Created: 2026-10-18
+/// @details This file contains JBCompressStream, an optional compression stage between a
+/// logger and its output.
+///
+/// You can find the source code and/ collaborate on
+/// [https://github.com/jonnybergdahl/Bergdahl_JBLogger](https://github.com/jonnybergdahl/Bergdahl_JBLogger).
+///
+/// This code is distributed under the MIT License. See the LICENSE file for details.
+#ifndef JBLOGGER_COMPRESS_H
+#define JBLOGGER_COMPRESS_H
+
+#include <Arduino.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "jblogger_compress_format.h"
+
+#ifndef JBLOGGER_COMPRESS_WINDOW_BITS
+#define JBLOGGER_COMPRESS_WINDOW_BITS 10		///< Window size as a power of two, uses 2 << bits bytes of RAM
+#endif
+#ifndef JBLOGGER_COMPRESS_LENGTH_BITS
+#define JBLOGGER_COMPRESS_LENGTH_BITS 6			///< Bits of the back reference length code
+#endif
+
+#define JBLOGGER_COMPRESS_WINDOW_SIZE (1 << JBLOGGER_COMPRESS_WINDOW_BITS)	///< Window size in bytes
+#define JBLOGGER_COMPRESS_MAX_MATCH ((1 << JBLOGGER_COMPRESS_LENGTH_BITS) + JBLOGGER_COMPRESS_MIN_MATCH - 2)	///< Longest back reference
+
+/// @brief Streaming compressor for log output
+/// @details This class compresses everything written to it, and writes the compressed data
+/// to another Print, for example a File or a network client. Use it as the output of a logger:
+///
+/// JBCompressStream compressed(file, moduleNames, 2);
+/// JBLogger logger("NET", LOG_LEVEL_INFO, compressed);
+///
+/// The compressor is an LZSS coder with a small sliding window, in the style of heatshrink.
+/// It uses no heap, about 2 << JBLOGGER_COMPRESS_WINDOW_BITS bytes of RAM for the window.
+/// Timestamps at the start of a line are replaced with the difference to the previous one,
+/// and the window is preloaded with a dictionary built from the module names, so the log
+/// prefixes compress well from the first line.
+///
+/// Compressed data is buffered until flush() is called, or until the window moves on. Call
+/// flush() before closing or uploading the output. The format is described in
+/// jblogger_compress_format.h, and extras/tools/jblog_decompress.cpp restores the log text,
+/// given the same module names.
+///
+class JBCompressStream final : public Stream {
+public:
+	/// @brief Constructor
+	/// @param output Print to write the compressed data to
+	/// @param moduleNames Module names used to build the dictionary, defaults to none
+	/// @param moduleCount Number of module names
+	///
+	JBCompressStream(Print &output, const char *const *moduleNames = nullptr, size_t moduleCount = 0);
+
+	/// @brief Compresses a byte
+	/// @param value Byte to compress
+	/// @return 1
+	size_t write(uint8_t value) override;
+
+	/// @brief Compresses a buffer
+	/// @param buffer Data to compress
+	/// @param size Number of bytes
+	/// @return size
+	size_t write(const uint8_t *buffer, size_t size) override;
+
+	using Print::write;
+
+	/// @brief Compresses all pending data and writes it to the output, ending with a sync marker
+	void flush() override;
+
+	/// @brief Always returns 0, the stream is write only
+	int available() override;
+
+	/// @brief Always returns -1, the stream is write only
+	int read() override;
+
+	/// @brief Always returns -1, the stream is write only
+	int peek() override;
+
+	/// @brief Returns the number of uncompressed bytes written
+	uint32_t getBytesIn() const;
+
+	/// @brief Returns the number of compressed bytes written to the output, including the header
+	uint32_t getBytesOut() const;
+
+private:
+	Print &_output;											///< Output for the compressed data
+	uint8_t _window[2 * JBLOGGER_COMPRESS_WINDOW_SIZE];		///< History followed by pending input
+	uint16_t _dictionaryLength = 0;							///< Length of the dictionary in the window
+	uint16_t _dictionaryChecksum = 0;						///< Checksum of the dictionary
+	uint16_t _position = 0;									///< Next byte in _window to compress
+	uint16_t _fill = 0;										///< Number of bytes in _window
+	uint8_t _bits = 0;										///< Bits not yet written
+	uint8_t _bitCount = 0;									///< Number of bits in _bits
+	uint8_t _outBuffer[32];									///< Compressed bytes not yet written
+	uint8_t _outLength = 0;									///< Number of bytes in _outBuffer
+	bool _headerWritten = false;							///< True when the header has been written
+	uint8_t _lineState;										///< Timestamp parser state
+	char _pending[12];										///< Possible timestamp being parsed
+	uint8_t _pendingLength = 0;								///< Number of bytes in _pending
+	uint32_t _timestamp = 0;								///< Timestamp being parsed
+	uint32_t _lastTimestamp = 0;							///< Previous timestamp
+	uint32_t _bytesIn = 0;									///< Uncompressed bytes written
+	uint32_t _bytesOut = 0;									///< Compressed bytes written
+
+	/// @brief Runs a byte through the timestamp parser
+	void _parse(uint8_t value);
+
+	/// @brief Passes the bytes of an unfinished timestamp on as text
+	void _abortTimestamp();
+
+	/// @brief Passes a byte of log text on to the compressor, escaping marker bytes
+	void _text(uint8_t value);
+
+	/// @brief Adds a byte to the compressor input
+	void _push(uint8_t value);
+
+	/// @brief Compresses the pending input
+	/// @param final If false, keeps JBLOGGER_COMPRESS_MAX_MATCH bytes for the next match
+	void _compress(bool final);
+
+	/// @brief Adds bits to the output, most significant bit first
+	void _writeBits(uint16_t value, uint8_t count);
+
+	/// @brief Adds a byte to the output buffer
+	void _writeByte(uint8_t value);
+
+	/// @brief Writes the output buffer to the output
+	void _flushOutput();
+
+	/// @brief Writes the header
+	void _writeHeader();
+};
+
+#endif // JBLOGGER_COMPRESS_H
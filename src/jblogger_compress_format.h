@@ -0,0 +1,98 @@
+/// @file jblogger_compress_format.h
+/// @author Jonny Bergdahl
+/// @brief Stream format of JBCompressStream
+/// @date Created: 2026-10-18
+/// @details This file contains the constants of the compressed log format, shared by
+/// JBCompressStream and the jblog_decompress host tool. It does not depend on Arduino.h.
+///
+/// A compressed log starts with a header:
+///
+/// | Bytes | Content                                            |
+/// |-------|----------------------------------------------------|
+/// | 4     | Magic, "JBLZ"                                      |
+/// | 1     | Version, JBLOGGER_COMPRESS_VERSION                 |
+/// | 1     | Window bits W                                      |
+/// | 1     | Length bits L                                      |
+/// | 2     | Dictionary length, little endian                   |
+/// | 2     | Dictionary checksum, Fletcher-16, little endian    |
+///
+/// The dictionary is not part of the stream. Both sides build it from the module names
+/// using JBCompressBuildDictionary() and preload it into the window, so the decoder needs
+/// the same module names, in the same order, as the JBCompressStream.
+///
+/// The header is followed by a bit stream of LZSS tokens, most significant bit first:
+///
+/// - `1` and 8 bits: a literal byte.
+/// - `0`, W bits distance - 1 and L bits length code: copy length code + MIN_MATCH - 1
+///   bytes from the window. A length code of 0 is a sync marker, and the stream continues
+///   at the next byte boundary. JBCompressStream::flush() writes one.
+///
+/// Before compression, a "(timestamp) " at the start of a line is replaced with the
+/// JBLOGGER_COMPRESS_TIMESTAMP byte and the difference to the previous timestamp as a
+/// varint, 7 bits per byte, least significant group first. Bytes in the log text equal to
+/// one of the two marker bytes are written as JBLOGGER_COMPRESS_ESCAPE and the byte.
+///
+/// You can find the source code and/ collaborate on
+/// [https://github.com/jonnybergdahl/Bergdahl_JBLogger](https://github.com/jonnybergdahl/Bergdahl_JBLogger).
+///
+/// This code is distributed under the MIT License. See the LICENSE file for details.
+#ifndef JBLOGGER_COMPRESS_FORMAT_H
+#define JBLOGGER_COMPRESS_FORMAT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define JBLOGGER_COMPRESS_MAGIC "JBLZ"			///< Magic at the start of a compressed log
+#define JBLOGGER_COMPRESS_VERSION 1				///< Version of the compressed log format
+#define JBLOGGER_COMPRESS_HEADER_LENGTH 11		///< Length of the header
+#define JBLOGGER_COMPRESS_MIN_MATCH 2			///< Length of a back reference with length code 1
+#define JBLOGGER_COMPRESS_TIMESTAMP 0x01		///< Marks a delta encoded timestamp
+#define JBLOGGER_COMPRESS_ESCAPE 0x02			///< Marks a literal marker byte in the log text
+
+/// @brief Builds the dictionary preloaded into the window
+///
+/// The dictionary holds the prefixes a logger writes after the timestamp, "E name: " to
+/// "T name: ", for each module name. Modules that do not fit are left out.
+///
+/// @param dictionary Buffer for the dictionary
+/// @param size Size of the buffer
+/// @param moduleNames Module names
+/// @param moduleCount Number of module names
+/// @return Length of the dictionary
+inline size_t JBCompressBuildDictionary(uint8_t *dictionary, size_t size,
+										const char *const *moduleNames, size_t moduleCount) {
+	static const char levels[] = "EWIDT";
+	size_t length = 0;
+	for (size_t i = 0; i < moduleCount; i++) {
+		const size_t nameLength = strlen(moduleNames[i]);
+		if (length + (sizeof(levels) - 1) * (nameLength + 4) > size) {
+			continue;
+		}
+		for (size_t level = 0; level < sizeof(levels) - 1; level++) {
+			dictionary[length++] = levels[level];
+			dictionary[length++] = ' ';
+			memcpy(dictionary + length, moduleNames[i], nameLength);
+			length += nameLength;
+			dictionary[length++] = ':';
+			dictionary[length++] = ' ';
+		}
+	}
+	return length;
+}
+
+/// @brief Returns the Fletcher-16 checksum of the dictionary, stored in the header
+/// @param dictionary The dictionary
+/// @param length Length of the dictionary
+/// @return The checksum
+inline uint16_t JBCompressChecksum(const uint8_t *dictionary, size_t length) {
+	uint16_t sum1 = 0;
+	uint16_t sum2 = 0;
+	for (size_t i = 0; i < length; i++) {
+		sum1 = (sum1 + dictionary[i]) % 255;
+		sum2 = (sum2 + sum1) % 255;
+	}
+	return static_cast<uint16_t>((sum2 << 8) | sum1);
+}
+
+#endif // JBLOGGER_COMPRESS_FORMAT_H
@@ -0,0 +1,237 @@
+/// @file jblogger_format.cpp
+/// @author Jonny Bergdahl
+/// @brief Compile-time parsed format strings for JBLogger
+/// @date Created: 2026-10-18
+/// @details This file contains the runtime formatting of argument slots.
+///
+/// You can find the source code and/ collaborate on
+/// [https://github.com/jonnybergdahl/Bergdahl_JBLogger](https://github.com/jonnybergdahl/Bergdahl_JBLogger).
+///
+/// This code is distributed under the MIT License. See the LICENSE file for details.
+#include "jblogger.h"
+#include <string.h>
+
+namespace jblogger {
+
+void FormatBuffer::append(const char* text, size_t length) {
+	if (length > available()) {
+		length = available();
+	}
+	memcpy(_buffer + _length, text, length);
+	_length += length;
+}
+
+void FormatBuffer::fill(char c, size_t count) {
+	if (count > available()) {
+		count = available();
+	}
+	memset(_buffer + _length, c, count);
+	_length += count;
+}
+
+/// @brief Pads a field of the given length to the segment width
+static size_t paddingFor(const Segment& segment, size_t length) {
+	return segment.width > length ? segment.width - length : 0;
+}
+
+template<class T>
+static void formatUnsigned(FormatBuffer& out, const Segment& segment, bool negative, T magnitude) {
+	char digits[24];
+	size_t count = 0;
+	const char* alphabet = segment.conversion == 'X' ? "0123456789ABCDEF" : "0123456789abcdef";
+	const unsigned base = (segment.conversion == 'x' || segment.conversion == 'X') ? 16 :
+						  segment.conversion == 'o' ? 8 : 10;
+
+	for (T value = magnitude; value != 0; value /= base) {
+		digits[count++] = alphabet[value % base];
+	}
+
+	// Precision is the minimum number of digits, a zero with precision 0 has no digits
+	size_t zeros = 0;
+	if (segment.precision < 0) {
+		zeros = count == 0 ? 1 : 0;
+	} else if (static_cast<size_t>(segment.precision) > count) {
+		zeros = segment.precision - count;
+	}
+
+	char prefix[2];
+	size_t prefixLength = 0;
+	if (negative) {
+		prefix[prefixLength++] = '-';
+	} else if (segment.conversion == 'd' || segment.conversion == 'i') {
+		if (segment.flags & FORMAT_FLAG_PLUS) {
+			prefix[prefixLength++] = '+';
+		} else if (segment.flags & FORMAT_FLAG_SPACE) {
+			prefix[prefixLength++] = ' ';
+		}
+	}
+	if ((segment.flags & FORMAT_FLAG_ALT) && magnitude != 0) {
+		if (base == 16) {
+			prefix[prefixLength++] = '0';
+			prefix[prefixLength++] = segment.conversion;
+		} else if (base == 8 && zeros == 0) {
+			zeros = 1;
+		}
+	}
+
+	size_t padding = paddingFor(segment, prefixLength + zeros + count);
+	if (!(segment.flags & FORMAT_FLAG_LEFT)) {
+		if ((segment.flags & FORMAT_FLAG_ZERO) && segment.precision < 0) {
+			zeros += padding;
+		} else {
+			out.fill(' ', padding);
+		}
+		padding = 0;
+	}
+	out.append(prefix, prefixLength);
+	out.fill('0', zeros);
+	while (count > 0) {
+		out.append(digits[--count]);
+	}
+	out.fill(' ', padding);
+}
+
+void formatInteger(FormatBuffer& out, const Segment& segment, bool negative, unsigned long magnitude) {
+	formatUnsigned(out, segment, negative, magnitude);
+}
+
+void formatInteger(FormatBuffer& out, const Segment& segment, bool negative, unsigned long long magnitude) {
+	formatUnsigned(out, segment, negative, magnitude);
+}
+
+void formatChar(FormatBuffer& out, const Segment& segment, char c) {
+	const size_t padding = paddingFor(segment, 1);
+	if (!(segment.flags & FORMAT_FLAG_LEFT)) {
+		out.fill(' ', padding);
+	}
+	out.append(c);
+	if (segment.flags & FORMAT_FLAG_LEFT) {
+		out.fill(' ', padding);
+	}
+}
+
+void formatString(FormatBuffer& out, const Segment& segment, const char* text) {
+	if (text == nullptr) {
+		text = "(null)";
+	}
+	size_t length = 0;
+	if (segment.precision < 0) {
+		length = strlen(text);
+	} else {
+		while (length < static_cast<size_t>(segment.precision) && text[length] != '\0') {
+			length++;
+		}
+	}
+
+	const size_t padding = paddingFor(segment, length);
+	if (!(segment.flags & FORMAT_FLAG_LEFT)) {
+		out.fill(' ', padding);
+	}
+	out.append(text, length);
+	if (segment.flags & FORMAT_FLAG_LEFT) {
+		out.fill(' ', padding);
+	}
+}
+
+void formatPointer(FormatBuffer& out, const Segment& segment, const void* pointer) {
+	Segment hex = segment;
+	hex.conversion = 'x';
+	hex.flags = static_cast<uint8_t>((segment.flags & FORMAT_FLAG_LEFT) | FORMAT_FLAG_ALT);
+	hex.precision = -1;
+	if (pointer == nullptr) {
+		// The alternate form adds no 0x to a zero value
+		formatString(out, hex, "0x0");
+		return;
+	}
+	formatUnsigned(out, hex, false, reinterpret_cast<uintptr_t>(pointer));
+}
+
+void formatFloating(FormatBuffer& out, const char* format, const Segment& segment, double value) {
+	// Floating point formatting is left to the C library, using the slot's own specification,
+	// with the length modifiers dropped, as the value is always passed as a double.
+	char spec[24];
+	size_t length = 0;
+	for (size_t i = 0; i < segment.length && length < sizeof(spec) - 1; i++) {
+		const char c = format[segment.offset + i];
+		if (strchr("hlLzjtq", c) == nullptr) {
+			spec[length++] = c;
+		}
+	}
+	spec[length] = '\0';
+
+	const int written = snprintf(out.end(), out.available() + 1, spec, value);
+	if (written > 0) {
+		out.advance(static_cast<size_t>(written));
+	}
+}
+
+template<class T>
+static void appendDecimal(FormatBuffer& out, bool negative, T magnitude) {
+	char digits[24];
+	size_t count = 0;
+	do {
+		digits[count++] = static_cast<char>('0' + magnitude % 10);
+		magnitude /= 10;
+	} while (magnitude != 0);
+	if (negative) {
+		digits[count++] = '-';
+	}
+	// The digits are in reverse order, when the number does not fit the leading ones are kept
+	const size_t length = count < out.available() ? count : out.available();
+	char* end = out.end();
+	for (size_t i = 0; i < length; i++) {
+		end[i] = digits[count - 1 - i];
+	}
+	out.advance(length);
+}
+
+void appendInteger(FormatBuffer& out, bool negative, unsigned long magnitude) {
+	appendDecimal(out, negative, magnitude);
+}
+
+void appendInteger(FormatBuffer& out, bool negative, unsigned long long magnitude) {
+	appendDecimal(out, negative, magnitude);
+}
+
+void appendFloating(FormatBuffer& out, double value, uint8_t digits) {
+	if (value != value) {
+		out.append("nan", 3);
+		return;
+	}
+	if (value > 4294967040.0 || value < -4294967040.0) {
+		// Also catches infinity
+		out.append(value > 0 ? "ovf" : "-ovf", value > 0 ? 3 : 4);
+		return;
+	}
+	if (digits > 9) {
+		digits = 9;
+	}
+
+	const bool negative = value < 0;
+	if (negative) {
+		value = -value;
+	}
+	unsigned long scale = 1;
+	for (uint8_t i = 0; i < digits; i++) {
+		scale *= 10;
+	}
+	value += 0.5 / scale;
+	const unsigned long integer = static_cast<unsigned long>(value);
+	unsigned long fraction = static_cast<unsigned long>((value - integer) * scale);
+	if (fraction >= scale) {
+		// Rounding error in the last digit
+		fraction = scale - 1;
+	}
+	appendDecimal(out, negative, integer);
+	if (digits > 0) {
+		char decimals[10];
+		decimals[0] = '.';
+		for (uint8_t i = digits; i > 0; i--) {
+			decimals[i] = static_cast<char>('0' + fraction % 10);
+			fraction /= 10;
+		}
+		out.append(decimals, digits + 1);
+	}
+}
+
+} // namespace jblogger
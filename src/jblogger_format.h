@@ -0,0 +1,580 @@
+/// @file jblogger_format.h
+/// @author Jonny Bergdahl
+/// @brief Compile-time parsed format strings for JBLogger
+/// @date Created: 2026-10-18
+/// @details This file contains the compile-time format string support for JBLogger.
+///
+/// A format string wrapped in JBFMT() is parsed by the compiler into a list of literal
+/// runs and typed argument slots. The argument count and argument types are checked
+/// against the format string at compile time, and the log call only has to walk the
+/// precompiled segment list at runtime.
+///
+/// The parser needs C++14 constexpr functions. With an older standard JBFMT() is not
+/// defined, and the rest of the logger works as before.
+///
+/// You can find the source code and/ collaborate on
+/// [https://github.com/jonnybergdahl/Bergdahl_JBLogger](https://github.com/jonnybergdahl/Bergdahl_JBLogger).
+///
+/// This code is distributed under the MIT License. See the LICENSE file for details.
+#ifndef JBLOGGER_FORMAT_H
+#define JBLOGGER_FORMAT_H
+
+#include <Arduino.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <type_traits>
+#ifdef ENABLE_STD_STRING
+#include <string>
+#endif
+
+#if __cplusplus >= 201402L
+#define JBLOGGER_HAS_JBFMT				///< Defined when JBFMT() is available, it needs C++14
+#endif
+
+#ifdef JBLOGGER_HAS_JBFMT
+/// @brief Wraps a string literal as a compile-time parsed format string
+///
+/// Use it in place of a plain format string, for example:
+///
+/// logger.info(JBFMT("Value: %d, name: %s"), value, name);
+///
+/// The format string is parsed at compile time, and passing the wrong number or the wrong
+/// type of arguments gives a compile error instead of garbage in the log.
+///
+#define JBFMT(format) ([] { \
+	struct JBLoggerFormatString : jblogger::FormatString { \
+		static constexpr const char* data() { return format; } \
+		static constexpr size_t size() { return sizeof(format); } \
+	}; \
+	return JBLoggerFormatString(); \
+}())
+#endif
+
+namespace jblogger {
+
+/// @brief Base class of all format string types created by JBFMT()
+struct FormatString {};
+
+/// @brief Checks whether a type is a format string type created by JBFMT()
+template<class T>
+struct IsFormatString : std::is_base_of<FormatString, T> {};
+
+/// @brief Conversion flags
+enum FormatFlag : uint8_t {
+	FORMAT_FLAG_LEFT = 0x01,		///< '-' Left align within the field width
+	FORMAT_FLAG_ZERO = 0x02,		///< '0' Pad with zeros
+	FORMAT_FLAG_PLUS = 0x04,		///< '+' Always write a sign
+	FORMAT_FLAG_SPACE = 0x08,		///< ' ' Write a space in place of a plus sign
+	FORMAT_FLAG_ALT = 0x10			///< '#' Alternate form
+};
+
+/// @brief A precompiled part of a format string
+///
+/// A segment is either a literal run, copied as is, or an argument slot holding the
+/// parsed conversion specification.
+///
+struct Segment {
+	uint16_t offset;				///< Offset of the literal run or the '%' in the format string
+	uint16_t length;				///< Length of the literal run or the conversion specification
+	char conversion;				///< Conversion character, 0 for a literal run
+	uint8_t flags;					///< FormatFlag bits
+	uint8_t width;					///< Minimum field width
+	int8_t precision;				///< Precision, -1 if not given
+};
+
+/// @brief A parsed format string
+/// @tparam N Number of segments
+template<size_t N>
+struct FormatSpec {
+	Segment segments[N > 0 ? N : 1];	///< Literal runs and argument slots
+	size_t count;					///< Number of segments, may be larger than N while counting
+	size_t argCount;				///< Number of argument slots
+	bool valid;						///< False if the format string uses an unsupported conversion
+};
+
+/// @brief Argument type classes accepted by the conversions
+enum class ArgClass : uint8_t {
+	Unsupported,					///< Type that can not be formatted
+	Integer,						///< Integral and enum types
+	Floating,						///< Floating point types
+	CString,						///< char* and const char*
+	Pointer,						///< Other pointers
+	StringObject					///< std::string and String, needs c_str()
+};
+
+/// @brief Maps an argument type to its ArgClass
+template<class T, class Enable = void>
+struct ArgTraits {
+	static constexpr ArgClass value = ArgClass::Unsupported;	///< Argument class
+};
+
+template<class T>
+struct ArgTraits<T, typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value>::type> {
+	static constexpr ArgClass value = ArgClass::Integer;		///< Argument class
+};
+
+template<class T>
+struct ArgTraits<T, typename std::enable_if<std::is_floating_point<T>::value>::type> {
+	static constexpr ArgClass value = ArgClass::Floating;		///< Argument class
+};
+
+template<class T>
+struct ArgTraits<T*> {
+	static constexpr ArgClass value = ArgClass::Pointer;		///< Argument class
+};
+
+template<>
+struct ArgTraits<char*> {
+	static constexpr ArgClass value = ArgClass::CString;		///< Argument class
+};
+
+template<>
+struct ArgTraits<const char*> {
+	static constexpr ArgClass value = ArgClass::CString;		///< Argument class
+};
+
+template<>
+struct ArgTraits<decltype(nullptr)> {
+	static constexpr ArgClass value = ArgClass::Pointer;		///< Argument class
+};
+
+#ifdef ENABLE_STD_STRING
+template<>
+struct ArgTraits<std::string> {
+	static constexpr ArgClass value = ArgClass::StringObject;	///< Argument class
+};
+#endif
+#ifdef ARDUINO
+template<>
+struct ArgTraits<String> {
+	static constexpr ArgClass value = ArgClass::StringObject;	///< Argument class
+};
+#endif
+
+/// @brief Returns the ArgClass of an argument type
+template<class T>
+constexpr ArgClass argClass() {
+	return ArgTraits<typename std::decay<T>::type>::value;
+}
+
+#ifdef JBLOGGER_HAS_JBFMT
+/// @brief Checks whether a character is a decimal digit
+constexpr bool isDigit(char c) {
+	return c >= '0' && c <= '9';
+}
+
+/// @brief Adds a segment to a FormatSpec, only counting it if there is no room left
+template<size_t N>
+constexpr void addSegment(FormatSpec<N>& spec, const Segment& segment) {
+	if (spec.count < N) {
+		spec.segments[spec.count] = segment;
+	}
+	spec.count++;
+}
+
+/// @brief Adds a literal run to a FormatSpec
+template<size_t N>
+constexpr void addLiteral(FormatSpec<N>& spec, size_t offset, size_t length) {
+	addSegment(spec, Segment { static_cast<uint16_t>(offset), static_cast<uint16_t>(length), 0, 0, 0, -1 });
+}
+
+/// @brief Parses a format string at compile time
+///
+/// Parse with N = 1 to get the segment count, then parse again with N set to that count
+/// to get a segment list without any unused entries.
+///
+/// Supports the flags "-0+ #", a decimal width and precision, and the conversions
+/// "diuxXocsfFeEgGaAp". Length modifiers are accepted but ignored, as the type of the
+/// argument decides how it is formatted. A '*' width or precision and %n are not supported.
+///
+/// @tparam N Maximum number of segments to store
+/// @param format The format string
+/// @return The parsed format string
+template<size_t N>
+constexpr FormatSpec<N> parseFormat(const char* format) {
+	FormatSpec<N> spec {};
+	spec.valid = true;
+	size_t i = 0;
+	size_t literalStart = 0;
+
+	while (format[i] != '\0') {
+		if (format[i] != '%') {
+			i++;
+			continue;
+		}
+		if (i > literalStart) {
+			addLiteral(spec, literalStart, i - literalStart);
+		}
+
+		Segment segment { static_cast<uint16_t>(i), 0, 0, 0, 0, -1 };
+		i++;
+		if (format[i] == '%') {
+			addLiteral(spec, i, 1);
+			i++;
+			literalStart = i;
+			continue;
+		}
+
+		// Flags
+		for (bool more = true; more; ) {
+			switch (format[i]) {
+				case '-': segment.flags |= FORMAT_FLAG_LEFT; i++; break;
+				case '0': segment.flags |= FORMAT_FLAG_ZERO; i++; break;
+				case '+': segment.flags |= FORMAT_FLAG_PLUS; i++; break;
+				case ' ': segment.flags |= FORMAT_FLAG_SPACE; i++; break;
+				case '#': segment.flags |= FORMAT_FLAG_ALT; i++; break;
+				default: more = false; break;
+			}
+		}
+
+		// Width
+		unsigned width = 0;
+		while (isDigit(format[i])) {
+			width = width * 10 + static_cast<unsigned>(format[i] - '0');
+			if (width > 255) {
+				width = 255;
+			}
+			i++;
+		}
+		segment.width = static_cast<uint8_t>(width);
+
+		// Precision
+		if (format[i] == '.') {
+			i++;
+			unsigned precision = 0;
+			while (isDigit(format[i])) {
+				precision = precision * 10 + static_cast<unsigned>(format[i] - '0');
+				if (precision > 127) {
+					precision = 127;
+				}
+				i++;
+			}
+			segment.precision = static_cast<int8_t>(precision);
+		}
+
+		// Length modifiers
+		while (format[i] == 'h' || format[i] == 'l' || format[i] == 'L' || format[i] == 'z' ||
+			   format[i] == 'j' || format[i] == 't' || format[i] == 'q') {
+			i++;
+		}
+
+		switch (format[i]) {
+			case 'd': case 'i': case 'u': case 'x': case 'X': case 'o': case 'c':
+			case 's': case 'p':
+			case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+				segment.conversion = format[i];
+				i++;
+				break;
+			default:
+				// '*', %n, unknown conversions and a '%' at the end of the string
+				spec.valid = false;
+				return spec;
+		}
+
+		segment.length = static_cast<uint16_t>(i - segment.offset);
+		addSegment(spec, segment);
+		spec.argCount++;
+		literalStart = i;
+	}
+
+	if (i > literalStart) {
+		addLiteral(spec, literalStart, i - literalStart);
+	}
+	return spec;
+}
+
+/// @brief Checks whether a conversion accepts an argument class
+constexpr bool accepts(char conversion, ArgClass argument) {
+	switch (conversion) {
+		case 'd': case 'i': case 'u': case 'x': case 'X': case 'o': case 'c':
+			return argument == ArgClass::Integer;
+		case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+			return argument == ArgClass::Floating;
+		case 's':
+			return argument == ArgClass::CString;
+		case 'p':
+			return argument == ArgClass::Pointer || argument == ArgClass::CString;
+		default:
+			return false;
+	}
+}
+
+/// @brief Checks the argument types against the argument slots of a parsed format string
+/// @param spec The parsed format string
+/// @param classes Argument classes, one per argument slot
+/// @param reportStringObjects If true, only fails on string objects given for a %s
+/// @return True if all arguments are accepted
+template<size_t N>
+constexpr bool argumentsMatch(const FormatSpec<N>& spec, const ArgClass* classes, bool reportStringObjects) {
+	size_t arg = 0;
+	for (size_t i = 0; i < spec.count && i < N; i++) {
+		const Segment& segment = spec.segments[i];
+		if (segment.conversion == 0) {
+			continue;
+		}
+		if (reportStringObjects) {
+			if (segment.conversion == 's' && classes[arg] == ArgClass::StringObject) {
+				return false;
+			}
+		} else if (!accepts(segment.conversion, classes[arg])) {
+			return false;
+		}
+		arg++;
+	}
+	return true;
+}
+#endif // JBLOGGER_HAS_JBFMT
+
+/// @brief Fixed size output buffer that silently truncates, like snprintf
+class FormatBuffer {
+public:
+	/// @brief Constructor
+	/// @param buffer Buffer to write to
+	/// @param size Size of the buffer, including room for the terminating null
+	FormatBuffer(char* buffer, size_t size)
+			: _buffer(buffer), _size(size), _length(0) {}
+
+	/// @brief Appends a character
+	/// @param c Character to append
+	void append(char c) {
+		if (_length + 1 < _size) {
+			_buffer[_length++] = c;
+		}
+	}
+
+	/// @brief Appends a run of characters
+	/// @param text Characters to append
+	/// @param length Number of characters
+	void append(const char* text, size_t length);
+
+	/// @brief Appends a character a number of times
+	/// @param c Character to append
+	/// @param count Number of times
+	void fill(char c, size_t count);
+
+	/// @brief Returns the number of characters that can still be appended
+	size_t available() const {
+		return _size - _length - 1;
+	}
+
+	/// @brief Returns the write position, for formatting directly into the buffer
+	char* end() {
+		return _buffer + _length;
+	}
+
+	/// @brief Moves the write position after formatting directly into the buffer
+	/// @param count Number of characters written, capped to available()
+	void advance(size_t count) {
+		_length += count < available() ? count : available();
+	}
+
+	/// @brief Returns the number of characters in the buffer
+	size_t length() const {
+		return _length;
+	}
+
+	/// @brief Returns the null terminated content of the buffer
+	const char* c_str() {
+		_buffer[_length] = '\0';
+		return _buffer;
+	}
+
+private:
+	char* _buffer;					///< Buffer
+	size_t _size;					///< Size of the buffer
+	size_t _length;					///< Number of characters written
+};
+
+#ifdef ARDUINO
+/// @brief Print that appends to a FormatBuffer, used to print a Printable into a line
+class FormatPrint : public Print {
+public:
+	/// @brief Constructor
+	/// @param out Buffer to append to
+	explicit FormatPrint(FormatBuffer& out)
+			: _out(out) {}
+
+	/// @brief Appends a character, it is dropped when the buffer is full
+	size_t write(uint8_t value) override {
+		_out.append(static_cast<char>(value));
+		return 1;
+	}
+
+	/// @brief Appends a run of characters, the ones that do not fit are dropped
+	size_t write(const uint8_t* buffer, size_t size) override {
+		_out.append(reinterpret_cast<const char*>(buffer), size);
+		return size;
+	}
+
+	using Print::write;
+
+private:
+	FormatBuffer& _out;				///< Buffer to append to
+};
+#endif
+
+/// @brief Formats an integer argument
+/// @param out Buffer to append to
+/// @param segment Argument slot
+/// @param negative True if the value is negative
+/// @param magnitude Absolute value
+void formatInteger(FormatBuffer& out, const Segment& segment, bool negative, unsigned long magnitude);
+
+/// @brief Formats an integer argument wider than long
+/// @param out Buffer to append to
+/// @param segment Argument slot
+/// @param negative True if the value is negative
+/// @param magnitude Absolute value
+void formatInteger(FormatBuffer& out, const Segment& segment, bool negative, unsigned long long magnitude);
+
+/// @brief Formats a %c argument
+/// @param out Buffer to append to
+/// @param segment Argument slot
+/// @param c Character
+void formatChar(FormatBuffer& out, const Segment& segment, char c);
+
+/// @brief Formats a %s argument
+/// @param out Buffer to append to
+/// @param segment Argument slot
+/// @param text String, nullptr is written as "(null)"
+void formatString(FormatBuffer& out, const Segment& segment, const char* text);
+
+/// @brief Formats a %p argument
+/// @param out Buffer to append to
+/// @param segment Argument slot
+/// @param pointer Pointer
+void formatPointer(FormatBuffer& out, const Segment& segment, const void* pointer);
+
+/// @brief Formats a floating point argument using snprintf with the slot's own specification
+/// @param out Buffer to append to
+/// @param format The format string
+/// @param segment Argument slot
+/// @param value Value
+void formatFloating(FormatBuffer& out, const char* format, const Segment& segment, double value);
+
+/// @brief Appends an integer in decimal, without padding
+///
+/// Like strings, an integer that does not fit is cut, keeping its leading digits.
+///
+/// @param out Buffer to append to
+/// @param negative True if the value is negative
+/// @param magnitude Absolute value
+void appendInteger(FormatBuffer& out, bool negative, unsigned long magnitude);
+
+/// @brief Appends an integer wider than long in decimal, without padding
+/// @param out Buffer to append to
+/// @param negative True if the value is negative
+/// @param magnitude Absolute value
+void appendInteger(FormatBuffer& out, bool negative, unsigned long long magnitude);
+
+/// @brief Appends a floating point value with a fixed number of decimals, as Print::print() does
+///
+/// Values too large for 32 bits are written as "ovf", like Print::print().
+///
+/// @param out Buffer to append to
+/// @param value Value
+/// @param digits Number of decimals, at most 9
+void appendFloating(FormatBuffer& out, double value, uint8_t digits);
+
+/// @brief Tag type used to dispatch on the ArgClass of an argument
+template<ArgClass C>
+using ArgTag = std::integral_constant<ArgClass, C>;
+
+/// @brief Returns the unsigned type used to format an integer type
+template<class T>
+using FormatUnsigned = typename std::conditional<(sizeof(T) > sizeof(unsigned long)),
+		unsigned long long, unsigned long>::type;
+
+/// @brief Returns the integer type used to format an integral or enum type
+template<class T, class Enable = void>
+struct FormatIntegerType {
+	typedef T type;					///< Integer type
+};
+
+template<class T>
+struct FormatIntegerType<T, typename std::enable_if<std::is_enum<T>::value>::type> {
+	typedef typename std::underlying_type<T>::type type;	///< Integer type
+};
+
+template<>
+struct FormatIntegerType<bool> {
+	typedef unsigned char type;		///< Integer type
+};
+
+template<class T>
+inline void formatArgument(FormatBuffer& out, const char*, const Segment& segment, T value,
+						   ArgTag<ArgClass::Integer>) {
+	typedef typename FormatIntegerType<T>::type Integer;
+	typedef typename std::make_unsigned<Integer>::type Unsigned;
+	const auto integer = static_cast<Integer>(value);
+
+	if (segment.conversion == 'c') {
+		formatChar(out, segment, static_cast<char>(integer));
+	} else if ((segment.conversion == 'd' || segment.conversion == 'i') && integer < 0) {
+		formatInteger(out, segment, true,
+					  static_cast<FormatUnsigned<Integer>>(static_cast<Unsigned>(0u - static_cast<Unsigned>(integer))));
+	} else {
+		formatInteger(out, segment, false,
+					  static_cast<FormatUnsigned<Integer>>(static_cast<Unsigned>(integer)));
+	}
+}
+
+template<class T>
+inline void formatArgument(FormatBuffer& out, const char* format, const Segment& segment, T value,
+						   ArgTag<ArgClass::Floating>) {
+	formatFloating(out, format, segment, static_cast<double>(value));
+}
+
+template<class T>
+inline void formatArgument(FormatBuffer& out, const char*, const Segment& segment, T value,
+						   ArgTag<ArgClass::CString>) {
+	if (segment.conversion == 'p') {
+		formatPointer(out, segment, value);
+	} else {
+		formatString(out, segment, value);
+	}
+}
+
+template<class T>
+inline void formatArgument(FormatBuffer& out, const char*, const Segment& segment, T value,
+						   ArgTag<ArgClass::Pointer>) {
+	formatPointer(out, segment, (const void*)value);
+}
+
+template<class T, ArgClass C>
+inline void formatArgument(FormatBuffer&, const char*, const Segment&, const T&, ArgTag<C>) {
+	// Rejected by the static_assert in JBLogger::log(), keeps the compiler output readable
+}
+
+/// @brief Writes the remaining literal runs
+/// @param out Buffer to append to
+/// @param format The format string
+/// @param segment First segment to write
+/// @param end End of the segment list
+inline void formatSegments(FormatBuffer& out, const char* format, const Segment* segment, const Segment* end) {
+	for (; segment != end; ++segment) {
+		out.append(format + segment->offset, segment->length);
+	}
+}
+
+/// @brief Walks a precompiled segment list, writing literal runs and formatting arguments
+/// @param out Buffer to append to
+/// @param format The format string
+/// @param segment First segment to write
+/// @param end End of the segment list
+/// @param value Argument for the next argument slot
+/// @param args Arguments for the remaining argument slots
+template<class T, typename... Args>
+inline void formatSegments(FormatBuffer& out, const char* format, const Segment* segment, const Segment* end,
+						   const T& value, const Args&... args) {
+	while (segment->conversion == 0) {
+		out.append(format + segment->offset, segment->length);
+		++segment;
+	}
+	formatArgument(out, format, *segment, value, ArgTag<argClass<T>()>());
+	formatSegments(out, format, segment + 1, end, args...);
+}
+
+} // namespace jblogger
+
+#endif // JBLOGGER_FORMAT_H
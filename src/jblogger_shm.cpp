@@ -0,0 +1,180 @@
+/// @file jblogger_shm.cpp
+/// @author Jonny Bergdahl
+/// @brief Shared memory log output for JBLogger on Linux
+/// @date Created: 2026-10-18
+/// @details This file contains the code for JBShmSink.
+///
+/// You can find the source code and/ collaborate on
+/// [https://github.com/jonnybergdahl/Bergdahl_JBLogger](https://github.com/jonnybergdahl/Bergdahl_JBLogger).
+///
+/// This code is distributed under the MIT License. See the LICENSE file for details.
+#include "jblogger_shm.h"
+
+#if defined(__linux__)
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/// @brief Returns the smallest power of two that is at least value, and at least 4 KB
+static uint32_t ringCapacity(size_t value) {
+	uint32_t capacity = 4096;
+	while (capacity < value && capacity < 0x80000000UL) {
+		capacity <<= 1;
+	}
+	return capacity;
+}
+
+JBShmSink::JBShmSink(const char *name, size_t size)
+		: _name(name), _capacity(ringCapacity(size)) {
+}
+
+JBShmSink::~JBShmSink() {
+	end();
+}
+
+bool JBShmSink::begin() {
+	end();
+
+	char path[128];
+	snprintf(path, sizeof(path), "/dev/shm/%s", _name);
+	const size_t total = sizeof(JBShmHeader) + _capacity;
+
+	int handle = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+	if (handle < 0) {
+		return false;
+	}
+	struct stat status;
+	bool reuse = fstat(handle, &status) == 0 && static_cast<size_t>(status.st_size) == total;
+	if (!reuse && status.st_size > 0) {
+		// Replace the file instead of resizing it, readers still mapping it would get SIGBUS
+		close(handle);
+		unlink(path);
+		handle = open(path, O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+		if (handle < 0) {
+			return false;
+		}
+	}
+	if (!reuse && ftruncate(handle, static_cast<off_t>(total)) != 0) {
+		close(handle);
+		return false;
+	}
+	void *memory = mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_SHARED, handle, 0);
+	close(handle);
+	if (memory == MAP_FAILED) {
+		return false;
+	}
+
+	_header = static_cast<JBShmHeader *>(memory);
+	_data = static_cast<uint8_t *>(memory) + sizeof(JBShmHeader);
+	reuse = reuse && _header->magic == JBLOGGER_SHM_MAGIC && _header->version == JBLOGGER_SHM_VERSION &&
+			_header->capacity == _capacity;
+	if (reuse) {
+		// Continue after the last complete record, a record the previous writer did not finish is dropped
+		_head = _header->head.load(std::memory_order_relaxed);
+		_oldest = _header->oldest.load(std::memory_order_relaxed);
+		_records = _header->records.load(std::memory_order_relaxed);
+		if (_header->reserved.load(std::memory_order_relaxed) != _head) {
+			// The unfinished record may have overwritten records after oldest, which was not
+			// updated yet, so all records before the head are dropped
+			_oldest = _head;
+			_header->oldest.store(_oldest, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+		}
+		_header->reserved.store(_head, std::memory_order_relaxed);
+	} else {
+		_head = 0;
+		_oldest = 0;
+		_records = 0;
+		_header->version = JBLOGGER_SHM_VERSION;
+		_header->capacity = _capacity;
+		_header->head.store(0, std::memory_order_relaxed);
+		_header->reserved.store(0, std::memory_order_relaxed);
+		_header->oldest.store(0, std::memory_order_relaxed);
+		_header->records.store(0, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		_header->magic = JBLOGGER_SHM_MAGIC;
+	}
+	_header->producer = static_cast<uint32_t>(getpid());
+	return true;
+}
+
+void JBShmSink::end() {
+	if (_header != nullptr) {
+		munmap(_header, sizeof(JBShmHeader) + _capacity);
+		_header = nullptr;
+		_data = nullptr;
+	}
+}
+
+size_t JBShmSink::write(uint8_t value) {
+	return write(&value, 1);
+}
+
+size_t JBShmSink::write(const uint8_t *buffer, size_t size) {
+	if (_header == nullptr || size == 0) {
+		return 0;
+	}
+	if (size > _capacity / 2 - sizeof(JBShmRecord)) {
+		size = _capacity / 2 - sizeof(JBShmRecord);
+	}
+
+	const uint64_t recordSize = JBShmRecordSize(static_cast<uint32_t>(size));
+	const uint64_t room = _capacity - (_head & (_capacity - 1));
+	const uint64_t padding = room < recordSize ? room : 0;
+	const uint64_t end = _head + padding + recordSize;
+
+	// Tell readers which records are about to be overwritten
+	_header->reserved.store(end, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	while (_oldest + _capacity < end) {
+		const JBShmRecord *oldest = _record(_oldest);
+		_oldest += oldest->length == JBLOGGER_SHM_PADDING ? _capacity - (_oldest & (_capacity - 1))
+														  : JBShmRecordSize(oldest->length);
+	}
+
+	if (padding > 0) {
+		_record(_head)->length = JBLOGGER_SHM_PADDING;
+		_head += padding;
+	}
+	JBShmRecord *record = _record(_head);
+	record->length = static_cast<uint32_t>(size);
+	record->sequence = static_cast<uint32_t>(_records);
+	memcpy(record + 1, buffer, size);
+	_head = end;
+	_records++;
+
+	_header->oldest.store(_oldest, std::memory_order_release);
+	_header->records.store(_records, std::memory_order_relaxed);
+	_header->head.store(_head, std::memory_order_release);
+	return size;
+}
+
+int JBShmSink::available() {
+	return 0;
+}
+
+int JBShmSink::read() {
+	return -1;
+}
+
+int JBShmSink::peek() {
+	return -1;
+}
+
+bool JBShmSink::isOpen() const {
+	return _header != nullptr;
+}
+
+uint64_t JBShmSink::getRecords() const {
+	return _records;
+}
+
+JBShmRecord *JBShmSink::_record(uint64_t position) const {
+	return reinterpret_cast<JBShmRecord *>(_data + (position & (_capacity - 1)));
+}
+
+#endif // __linux__
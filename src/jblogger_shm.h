@@ -0,0 +1,108 @@
+/// @file jblogger_shm.h
+/// @author Jonny Bergdahl
+/// @brief Shared memory log output for JBLogger on Linux
+/// @date Created: 2026-10-18
+/// @details This file contains JBShmSink, an output that writes log records to a ring in
+/// shared memory, for Linux hosted builds.
+///
+/// You can find the source code and/ collaborate on
+/// [https://github.com/jonnybergdahl/Bergdahl_JBLogger](https://github.com/jonnybergdahl/Bergdahl_JBLogger).
+///
+/// This code is distributed under the MIT License. See the LICENSE file for details.
+#ifndef JBLOGGER_SHM_H
+#define JBLOGGER_SHM_H
+
+#if defined(__linux__)
+
+#include <Arduino.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "jblogger_shm_format.h"
+
+#ifndef JBLOGGER_SHM_SIZE
+#define JBLOGGER_SHM_SIZE (1024 * 1024UL)		///< Default size of the data area, rounded up to a power of two
+#endif
+
+/// @brief Shared memory log output
+/// @details This class writes each write() as a record to a memory mapped ring in /dev/shm.
+/// Logging costs a memcpy, there is no system call and no pipe. A reader process, such as
+/// extras/tools/jblog_shm_reader.cpp, maps the same file read only and follows the ring.
+/// Readers can attach and detach at any time, and never slow down the writer. When a reader
+/// falls behind by more than the ring size it skips the overwritten records.
+///
+/// The ring is a file, so the records stay readable after the process exits or crashes.
+/// When the process starts again it continues after the last record.
+///
+/// JBShmSink shm("gateway");
+/// shm.begin();
+/// JBBasicLogger<JBShmSink> logger("NET", LOG_LEVEL_INFO, shm);
+///
+/// The layout is described in jblogger_shm_format.h. There must be only one writer for each
+/// ring, and calls to write() must not run concurrently.
+///
+class JBShmSink final : public Stream {
+public:
+	/// @brief Constructor
+	/// @param name Name of the ring, the file is /dev/shm/name
+	/// @param size Size of the data area, rounded up to a power of two, defaults to JBLOGGER_SHM_SIZE
+	///
+	explicit JBShmSink(const char *name, size_t size = JBLOGGER_SHM_SIZE);
+
+	/// @brief Destructor, unmaps the ring but leaves the file
+	~JBShmSink() override;
+
+	/// @brief Creates or opens the ring and maps it
+	///
+	/// An existing ring with the same size is continued, otherwise it is created empty. If the
+	/// previous writer stopped in the middle of a record, the records of the ring are dropped.
+	///
+	/// @return True if the ring is ready for writing
+	bool begin();
+
+	/// @brief Unmaps the ring, the file is left for readers
+	void end();
+
+	/// @brief Writes a byte as a record, prefer writing complete lines
+	/// @param value Byte to write
+	/// @return 1 if written, 0 if the ring is not mapped
+	size_t write(uint8_t value) override;
+
+	/// @brief Writes a buffer as one record
+	/// @param buffer Data to write, longer data is truncated to half the ring size
+	/// @param size Number of bytes
+	/// @return Number of bytes written, 0 if the ring is not mapped
+	size_t write(const uint8_t *buffer, size_t size) override;
+
+	using Print::write;
+
+	/// @brief Always returns 0, the stream is write only
+	int available() override;
+
+	/// @brief Always returns -1, the stream is write only
+	int read() override;
+
+	/// @brief Always returns -1, the stream is write only
+	int peek() override;
+
+	/// @brief Returns true if the ring is mapped
+	bool isOpen() const;
+
+	/// @brief Returns the number of records written to the ring, by all processes
+	uint64_t getRecords() const;
+
+private:
+	const char *_name;										///< Name of the ring
+	uint32_t _capacity;										///< Size of the data area
+	JBShmHeader *_header = nullptr;							///< Mapped ring, or nullptr
+	uint8_t *_data = nullptr;								///< Data area of the mapped ring
+	uint64_t _head = 0;										///< Writer copy of head
+	uint64_t _oldest = 0;									///< Writer copy of oldest
+	uint64_t _records = 0;									///< Writer copy of records
+
+	/// @brief Returns the record at a position
+	JBShmRecord *_record(uint64_t position) const;
+};
+
+#endif // __linux__
+
+#endif // JBLOGGER_SHM_H
@@ -0,0 +1,73 @@
+/// @file jblogger_shm_format.h
+/// @author Jonny Bergdahl
+/// @brief Shared memory ring format of JBShmSink
+/// @date Created: 2026-10-18
+/// @details This file contains the layout of the shared memory log ring, shared by JBShmSink
+/// and the jblog_shm_reader host tool. It does not depend on Arduino.h.
+///
+/// The ring is a file in /dev/shm, a JBShmHeader followed by a data area of a power of two
+/// bytes. Positions are byte counts since the ring was created, the offset in the data area
+/// is the position modulo the capacity.
+///
+/// The data area holds records, each a JBShmRecord followed by the text, padded to
+/// JBLOGGER_SHM_ALIGN bytes. A record never wraps, when it does not fit before the end of
+/// the data area a padding record fills the rest, with length JBLOGGER_SHM_PADDING.
+///
+/// There is a single writer, which works like a seqlock:
+///
+/// 1. Store `reserved`, the position the write will end at, then a release fence.
+/// 2. Write the records, then store `oldest`, the first record not overwritten.
+/// 3. Store `head`, with release.
+///
+/// A reader loads `head` with acquire, and reads the records below it. After reading a
+/// record it issues an acquire fence and loads `reserved`. If the record starts below
+/// `reserved` - capacity the writer may have overwritten it while it was read, so the
+/// record is discarded and the reader continues at `oldest`.
+///
+/// You can find the source code and/ collaborate on
+/// [https://github.com/jonnybergdahl/Bergdahl_JBLogger](https://github.com/jonnybergdahl/Bergdahl_JBLogger).
+///
+/// This code is distributed under the MIT License. See the LICENSE file for details.
+#ifndef JBLOGGER_SHM_FORMAT_H
+#define JBLOGGER_SHM_FORMAT_H
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+#define JBLOGGER_SHM_MAGIC 0x4d53424aUL			///< Magic at the start of the ring, "JBSM"
+#define JBLOGGER_SHM_VERSION 1					///< Version of the ring format
+#define JBLOGGER_SHM_ALIGN 8					///< Alignment of the records
+#define JBLOGGER_SHM_PADDING 0xffffffffUL		///< Record length of a padding record
+
+/// @brief Header at the start of the shared memory ring
+struct JBShmHeader {
+	uint32_t magic;								///< JBLOGGER_SHM_MAGIC
+	uint32_t version;							///< JBLOGGER_SHM_VERSION
+	uint32_t capacity;							///< Size of the data area, a power of two
+	uint32_t producer;							///< Process id of the last writer
+	std::atomic<uint64_t> head;					///< Position after the last complete record
+	std::atomic<uint64_t> reserved;				///< Position the write in progress ends at
+	std::atomic<uint64_t> oldest;				///< Position of the oldest complete record
+	std::atomic<uint64_t> records;				///< Number of records written
+	uint8_t padding[16];					///< Pads the header to 64 bytes
+};
+
+/// @brief Header of a record in the data area
+struct JBShmRecord {
+	uint32_t length;							///< Length of the text, or JBLOGGER_SHM_PADDING
+	uint32_t sequence;							///< Record number, lower 32 bits
+};
+
+static_assert(sizeof(JBShmHeader) == 64, "JBShmHeader must be 64 bytes");
+static_assert(sizeof(JBShmRecord) == JBLOGGER_SHM_ALIGN, "JBShmRecord must be one alignment unit");
+
+/// @brief Returns the space a record with a given text length uses in the data area
+/// @param length Length of the text
+/// @return Size of the record, including the header and padding
+inline uint64_t JBShmRecordSize(uint32_t length) {
+	return (sizeof(JBShmRecord) + static_cast<uint64_t>(length) + JBLOGGER_SHM_ALIGN - 1) &
+		   ~static_cast<uint64_t>(JBLOGGER_SHM_ALIGN - 1);
+}
+
+#endif // JBLOGGER_SHM_FORMAT_H
@@ -0,0 +1,125 @@
+/// @file jblogger_sink.h
+/// @author Jonny Bergdahl
+/// @brief Output sinks for JBLogger
+/// @date Created: 2026-10-18
+/// @details This file contains the sink support for JBBasicLogger.
+///
+/// A sink is any class with a `write(const uint8_t* buffer, size_t size)` member. The logger
+/// composes each line in a buffer and hands it to the sink in a single write. For a concrete
+/// sink type the write is called without virtual dispatch, so it can be inlined.
+///
+/// You can find the source code and/ collaborate on
+/// [https://github.com/jonnybergdahl/Bergdahl_JBLogger](https://github.com/jonnybergdahl/Bergdahl_JBLogger).
+///
+/// This code is distributed under the MIT License. See the LICENSE file for details.
+#ifndef JBLOGGER_SINK_H
+#define JBLOGGER_SINK_H
+
+#include <Arduino.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+
+/// @brief Writes a complete buffer to a sink
+///
+/// The default implementation uses a qualified call, which bypasses virtual dispatch, when
+/// Sink is not polymorphic or is final, so no derived class can override the write. Other
+/// sink types, like an abstract Client given a WiFiClient, use a normal virtual call. The
+/// Print and Stream specializations are used by the type-erased JBLogger.
+///
+/// \tparam Sink The sink type.
+///
+template<class Sink>
+struct JBLoggerSinkTraits {
+	/// @brief Writes a buffer to the sink
+	/// @param sink The sink
+	/// @param buffer Data to write
+	/// @param size Number of bytes to write
+	static void write(Sink& sink, const char* buffer, size_t size) {
+#if __cplusplus >= 201402L
+		_write(sink, reinterpret_cast<const uint8_t*>(buffer), size,
+			   std::integral_constant<bool, !std::is_polymorphic<Sink>::value || std::is_final<Sink>::value>());
+#else
+		_write(sink, reinterpret_cast<const uint8_t*>(buffer), size,
+			   std::integral_constant<bool, !std::is_polymorphic<Sink>::value>());
+#endif
+	}
+
+private:
+	/// @brief Writes with a qualified call, the sink is exactly of type Sink
+	static void _write(Sink& sink, const uint8_t* buffer, size_t size, std::true_type) {
+		sink.Sink::write(buffer, size);
+	}
+
+	/// @brief Writes with a normal call, the sink may be of a derived type
+	static void _write(Sink& sink, const uint8_t* buffer, size_t size, std::false_type) {
+		sink.write(buffer, size);
+	}
+};
+
+template<>
+struct JBLoggerSinkTraits<Print> {
+	/// @brief Writes a buffer to the sink
+	/// @param sink The sink
+	/// @param buffer Data to write
+	/// @param size Number of bytes to write
+	static void write(Print& sink, const char* buffer, size_t size) {
+		sink.write(reinterpret_cast<const uint8_t*>(buffer), size);
+	}
+};
+
+template<>
+struct JBLoggerSinkTraits<Stream> {
+	/// @brief Writes a buffer to the sink
+	/// @param sink The sink
+	/// @param buffer Data to write
+	/// @param size Number of bytes to write
+	static void write(Stream& sink, const char* buffer, size_t size) {
+		sink.write(reinterpret_cast<const uint8_t*>(buffer), size);
+	}
+};
+
+/// @brief A sink that collects log output in a fixed size memory buffer
+///
+/// Output that does not fit is dropped. Use clear() to empty the buffer.
+///
+/// \tparam Size Size of the buffer in bytes.
+///
+template<size_t Size>
+class JBMemorySink {
+public:
+	/// @brief Appends data to the buffer
+	/// @param buffer Data to write
+	/// @param size Number of bytes to write
+	/// @return Number of bytes written
+	size_t write(const uint8_t* buffer, size_t size) {
+		if (size > Size - _length) {
+			size = Size - _length;
+		}
+		memcpy(_buffer + _length, buffer, size);
+		_length += size;
+		return size;
+	}
+
+	/// @brief Returns the collected output, not null terminated
+	const char* data() const {
+		return _buffer;
+	}
+
+	/// @brief Returns the number of bytes collected
+	size_t length() const {
+		return _length;
+	}
+
+	/// @brief Empties the buffer
+	void clear() {
+		_length = 0;
+	}
+
+private:
+	char _buffer[Size];				///< Buffer
+	size_t _length = 0;				///< Number of bytes used
+};
+
+#endif // JBLOGGER_SINK_H
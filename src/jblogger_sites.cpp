@@ -0,0 +1,275 @@
+/// @file jblogger_sites.cpp
+/// @author Jonny Bergdahl
+/// @brief Per call site log switches for JBLogger
+/// @date Created: 2026-10-18
+/// @details This file contains the code for JBLogSites and JBLogSiteConsole.
+///
+/// You can find the source code and/ collaborate on
+/// [https://github.com/jonnybergdahl/Bergdahl_JBLogger](https://github.com/jonnybergdahl/Bergdahl_JBLogger).
+///
+/// This code is distributed under the MIT License. See the LICENSE file for details.
+#include "jblogger_sites.h"
+#include <stdlib.h>
+#include <string.h>
+
+JBLogSite *JBLogSites::_first = nullptr;
+
+#if JBLOGGER_MAX_SITE_RULES > 0
+JBLogSites::Rule JBLogSites::_rules[JBLOGGER_MAX_SITE_RULES];
+uint8_t JBLogSites::_ruleCount = 0;
+#endif
+
+// Guards the site list and the rules, sites can first run on several tasks or cores at once
+#if defined(ESP32)
+static portMUX_TYPE sitesLock = portMUX_INITIALIZER_UNLOCKED;
+#define SITES_LOCK() portENTER_CRITICAL(&sitesLock)
+#define SITES_UNLOCK() portEXIT_CRITICAL(&sitesLock)
+#else
+#define SITES_LOCK() noInterrupts()
+#define SITES_UNLOCK() interrupts()
+#endif
+
+/// @brief Matches text against a pattern with '*' and '?' wildcards
+static bool matchPattern(const char *pattern, const char *text) {
+	const char *star = nullptr;
+	const char *retry = nullptr;
+	while (*text != '\0') {
+		if (*pattern == '*') {
+			star = pattern++;
+			retry = text;
+		} else if (*pattern == '?' || *pattern == *text) {
+			pattern++;
+			text++;
+		} else if (star != nullptr) {
+			pattern = star + 1;
+			text = ++retry;
+		} else {
+			return false;
+		}
+	}
+	while (*pattern == '*') {
+		pattern++;
+	}
+	return *pattern == '\0';
+}
+
+/// @brief Matches a file pattern against the full path, or the file name
+static bool matchFile(const char *pattern, const char *path) {
+	if (matchPattern(pattern, path)) {
+		return true;
+	}
+	const char *name = path;
+	for (const char *c = path; *c != '\0'; c++) {
+		if (*c == '/' || *c == '\\') {
+			name = c + 1;
+		}
+	}
+	return name != path && matchPattern(pattern, name);
+}
+
+/// @brief Returns the name of a site mode
+static const char *modeName(uint8_t mode) {
+	switch (mode) {
+		case JBLOG_SITE_ON: return "on";
+		case JBLOG_SITE_OFF: return "off";
+		default: return "default";
+	}
+}
+
+void JBLogSites::add(JBLogSite &site) {
+	SITES_LOCK();
+	// Another task may have added the site since the caller checked the mode
+	if (site.mode == JBLOG_SITE_NEW) {
+		uint8_t mode = JBLOG_SITE_DEFAULT;
+#if JBLOGGER_MAX_SITE_RULES > 0
+		// Later changes win, so apply them in order
+		for (uint8_t i = 0; i < _ruleCount; i++) {
+			const Rule &rule = _rules[i];
+			if (matches(site, rule.file[0] != '\0' ? rule.file : nullptr, rule.firstLine, rule.lastLine,
+						rule.format[0] != '\0' ? rule.format : nullptr)) {
+				mode = rule.mode;
+			}
+		}
+#endif
+		site.next = _first;
+		_first = &site;
+		site.mode = mode;
+	}
+	SITES_UNLOCK();
+}
+
+JBLogSite *JBLogSites::first() {
+	return _first;
+}
+
+size_t JBLogSites::set(const char *file, uint16_t firstLine, uint16_t lastLine,
+					   const char *format, JBLogSiteMode mode) {
+	if (mode == JBLOG_SITE_NEW) {
+		return 0;
+	}
+	size_t count = 0;
+	SITES_LOCK();
+	for (JBLogSite *site = _first; site != nullptr; site = site->next) {
+		if (matches(*site, file, firstLine, lastLine, format)) {
+			site->mode = mode;
+			count++;
+		}
+	}
+
+#if JBLOGGER_MAX_SITE_RULES > 0
+	// Patterns that do not fit would match other sites, so they are not remembered
+	if ((file == nullptr || strlen(file) <= JBLOGGER_MAX_SITE_PATTERN) &&
+		(format == nullptr || strlen(format) <= JBLOGGER_MAX_SITE_PATTERN)) {
+		if (_ruleCount == JBLOGGER_MAX_SITE_RULES) {
+			memmove(_rules, _rules + 1, sizeof(Rule) * (JBLOGGER_MAX_SITE_RULES - 1));
+			_ruleCount--;
+		}
+		Rule &rule = _rules[_ruleCount++];
+		strcpy(rule.file, file != nullptr ? file : "");
+		strcpy(rule.format, format != nullptr ? format : "");
+		rule.firstLine = firstLine;
+		rule.lastLine = lastLine;
+		rule.mode = mode;
+	}
+#endif
+	SITES_UNLOCK();
+	return count;
+}
+
+void JBLogSites::reset(JBLogSiteMode mode) {
+	if (mode == JBLOG_SITE_NEW) {
+		return;
+	}
+	SITES_LOCK();
+	for (JBLogSite *site = _first; site != nullptr; site = site->next) {
+		site->mode = mode;
+	}
+#if JBLOGGER_MAX_SITE_RULES > 0
+	_ruleCount = 0;
+#endif
+	SITES_UNLOCK();
+}
+
+void JBLogSites::list(Print &output, const char *file) {
+	static const char levelNames[] = "NEWIDT";
+	for (const JBLogSite *site = _first; site != nullptr; site = site->next) {
+		if (file != nullptr && !matchFile(file, site->file)) {
+			continue;
+		}
+		output.print(site->file);
+		output.print(':');
+		output.print(static_cast<unsigned int>(site->line));
+		output.print(" [");
+		output.print(modeName(site->mode));
+		output.print("] ");
+		output.print(site->level < sizeof(levelNames) - 1 ? levelNames[site->level] : '?');
+		output.print(' ');
+		output.println(site->format);
+	}
+}
+
+bool JBLogSites::command(const char *command, Print &output) {
+	char buffer[JBLOGGER_MAX_SITE_COMMAND + 1];
+	strncpy(buffer, command, JBLOGGER_MAX_SITE_COMMAND);
+	buffer[JBLOGGER_MAX_SITE_COMMAND] = '\0';
+
+	// Split into words
+	char *words[10];
+	size_t count = 0;
+	for (char *c = buffer; *c != '\0' && count < 10; ) {
+		while (*c == ' ' || *c == '\t') {
+			*c++ = '\0';
+		}
+		if (*c == '\0') {
+			break;
+		}
+		words[count++] = c;
+		while (*c != '\0' && *c != ' ' && *c != '\t') {
+			c++;
+		}
+	}
+	if (count == 0) {
+		return false;
+	}
+
+	if (strcmp(words[0], "list") == 0 && count <= 2) {
+		list(output, count == 2 ? words[1] : nullptr);
+		return true;
+	}
+	if (strcmp(words[0], "reset") == 0 && count == 1) {
+		reset();
+		output.println("all sites default");
+		return true;
+	}
+
+	const char *file = nullptr;
+	const char *format = nullptr;
+	uint16_t firstLine = 0;
+	uint16_t lastLine = 0;
+	size_t i = 0;
+	for (; i + 1 < count; i += 2) {
+		if (strcmp(words[i], "file") == 0) {
+			file = words[i + 1];
+		} else if (strcmp(words[i], "format") == 0) {
+			format = words[i + 1];
+		} else if (strcmp(words[i], "line") == 0) {
+			char *end;
+			firstLine = static_cast<uint16_t>(strtoul(words[i + 1], &end, 10));
+			lastLine = *end == '-' ? static_cast<uint16_t>(strtoul(end + 1, &end, 10)) : 0;
+			if (*end != '\0' || firstLine == 0) {
+				break;
+			}
+		} else {
+			break;
+		}
+	}
+
+	JBLogSiteMode mode;
+	if (i + 1 != count) {
+		output.println("usage: list [file] | reset | [file <file>] [line <line>[-<line>]] [format <text>] on|off|default");
+		return false;
+	} else if (strcmp(words[i], "on") == 0) {
+		mode = JBLOG_SITE_ON;
+	} else if (strcmp(words[i], "off") == 0) {
+		mode = JBLOG_SITE_OFF;
+	} else if (strcmp(words[i], "default") == 0) {
+		mode = JBLOG_SITE_DEFAULT;
+	} else {
+		output.println("mode must be on, off or default");
+		return false;
+	}
+
+	output.print(static_cast<unsigned int>(set(file, firstLine, lastLine, format, mode)));
+	output.print(" sites ");
+	output.println(modeName(mode));
+	return true;
+}
+
+bool JBLogSites::matches(const JBLogSite &site, const char *file, uint16_t firstLine,
+						 uint16_t lastLine, const char *format) {
+	if (firstLine != 0 && (site.line < firstLine || site.line > (lastLine != 0 ? lastLine : firstLine))) {
+		return false;
+	}
+	if (file != nullptr && !matchFile(file, site.file)) {
+		return false;
+	}
+	return format == nullptr || strstr(site.format, format) != nullptr;
+}
+
+JBLogSiteConsole::JBLogSiteConsole(Stream &stream)
+		: _stream(stream) {}
+
+void JBLogSiteConsole::loop() {
+	while (_stream.available() > 0) {
+		const int c = _stream.read();
+		if (c == '\r' || c == '\n') {
+			if (_length > 0) {
+				_command[_length] = '\0';
+				_length = 0;
+				JBLogSites::command(_command, _stream);
+			}
+		} else if (c >= 0 && _length < JBLOGGER_MAX_SITE_COMMAND) {
+			_command[_length++] = static_cast<char>(c);
+		}
+	}
+}
@@ -0,0 +1,176 @@
+/// @file jblogger_sites.h
+/// @author Jonny Bergdahl
+/// @brief Per call site log switches for JBLogger
+/// @date Created: 2026-10-18
+/// @details This file contains the call site support, which allows single debug and trace
+/// calls to be turned on or off at runtime, independent of the log level of the logger.
+///
+/// Use the JBLOG_DEBUG() and JBLOG_TRACE() macros instead of debug() and trace():
+///
+/// JBLOG_DEBUG(logger, "rssi %d", WiFi.RSSI());
+///
+/// Each macro call defines a static JBLogSite holding the file, line and format of the call,
+/// and a mode byte. The mode is checked before anything else, so a site that is turned off
+/// costs a single byte load. A site adds itself to the site list the first time it runs.
+///
+/// Sites are listed and changed by file, line or format using JBLogSites, or with text
+/// commands such as "file wifi.cpp line 120 on", for example read from Serial using
+/// JBLogSiteConsole.
+///
+/// You can find the source code and/ collaborate on
+/// [https://github.com/jonnybergdahl/Bergdahl_JBLogger](https://github.com/jonnybergdahl/Bergdahl_JBLogger).
+///
+/// This code is distributed under the MIT License. See the LICENSE file for details.
+#ifndef JBLOGGER_SITES_H
+#define JBLOGGER_SITES_H
+
+#include <Arduino.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef JBLOGGER_MAX_SITE_RULES
+#define JBLOGGER_MAX_SITE_RULES 4			///< Changes remembered for sites that have not run yet, 0 to disable
+#endif
+#define JBLOGGER_MAX_SITE_PATTERN 24		///< Maximum length of a remembered file or format pattern
+#define JBLOGGER_MAX_SITE_COMMAND 80		///< Maximum length of a JBLogSiteConsole command
+
+/// @brief Call site modes
+enum JBLogSiteMode : uint8_t {
+	JBLOG_SITE_NEW = 0,					///< Not run yet, not in the site list
+	JBLOG_SITE_DEFAULT,					///< Logs when the log level of the logger allows it
+	JBLOG_SITE_ON,						///< Always logs
+	JBLOG_SITE_OFF						///< Never logs
+};
+
+/// @brief Descriptor of a log call site, defined by JBLOG_SITE()
+///
+/// This is an aggregate, so a static JBLogSite is initialized at compile time.
+///
+struct JBLogSite {
+	const char *file;					///< Source file
+	const char *format;					///< Format argument, as written in the source
+	uint16_t line;						///< Source line
+	uint8_t level;						///< Log level of the call
+	uint8_t mode;						///< JBLogSiteMode
+	JBLogSite *next;					///< Next site in the site list
+};
+
+/// @brief Logs a message at a call site that can be turned on and off at runtime
+/// @param logger The logger, a JBLogger or JBBasicLogger
+/// @param level Log level of the message
+/// @param format Format string, of any type accepted by log()
+/// @param ... Arguments to be formatted according to the format string
+#define JBLOG_SITE(logger, level, format, ...) JBLOG_SITE_TEXT(logger, level, #format, format, ##__VA_ARGS__)
+
+/// @brief Logs a message with the DEBUG log level, at a call site that can be turned on and off
+#define JBLOG_DEBUG(logger, format, ...) JBLOG_SITE_TEXT(logger, LOG_LEVEL_DEBUG, #format, format, ##__VA_ARGS__)
+
+/// @brief Logs a message with the TRACE log level, at a call site that can be turned on and off
+#define JBLOG_TRACE(logger, format, ...) JBLOG_SITE_TEXT(logger, LOG_LEVEL_TRACE, #format, format, ##__VA_ARGS__)
+
+/// @brief Implements JBLOG_SITE(), text is the format argument as written in the source
+#define JBLOG_SITE_TEXT(logger, level, text, format, ...) \
+	do { \
+		static JBLogSite _jblogSite = { __FILE__, text, __LINE__, level, JBLOG_SITE_NEW, nullptr }; \
+		if (_jblogSite.mode != JBLOG_SITE_OFF) { \
+			(logger).logSite(_jblogSite, level, format, ##__VA_ARGS__); \
+		} \
+	} while (0)
+
+/// @brief The list of call sites
+/// @details All functions are static. A site is selected by a file, a line and a format
+/// pattern, each of them optional:
+///
+/// - file: matches the full path or the file name, '*' and '?' can be used as wildcards.
+/// - line: the line, or lines from firstLine to lastLine.
+/// - format: matches sites having the text in their format argument.
+///
+/// Changes are also remembered, up to JBLOGGER_MAX_SITE_RULES of them, and applied to sites
+/// that have not run yet when they first run.
+///
+class JBLogSites {
+public:
+	/// @brief Adds a site to the list, called by the logger the first time a site runs
+	/// @param site Site to add
+	static void add(JBLogSite &site);
+
+	/// @brief Returns the first site in the list, use JBLogSite::next to get the rest
+	static JBLogSite *first();
+
+	/// @brief Sets the mode of the matching sites
+	/// @param file File pattern, or nullptr for any file
+	/// @param firstLine First line, or 0 for any line
+	/// @param lastLine Last line, or 0 for firstLine only
+	/// @param format Format text, or nullptr for any format
+	/// @param mode Mode to set
+	/// @return Number of sites changed
+	static size_t set(const char *file, uint16_t firstLine, uint16_t lastLine,
+					  const char *format, JBLogSiteMode mode);
+
+	/// @brief Sets the mode of all sites, and forgets the remembered changes
+	/// @param mode Mode to set
+	static void reset(JBLogSiteMode mode = JBLOG_SITE_DEFAULT);
+
+	/// @brief Lists the sites, one per line, as "file:line [mode] level format"
+	/// @param output Print to write the list to
+	/// @param file File pattern, or nullptr for any file
+	static void list(Print &output, const char *file = nullptr);
+
+	/// @brief Runs a text command
+	///
+	/// Commands are:
+	///
+	/// - `list [file]`: lists the sites.
+	/// - `[file <file>] [line <line>[-<lastLine>]] [format <text>] on|off|default`: sets the
+	///   mode of the matching sites.
+	/// - `reset`: sets all sites to default.
+	///
+	/// @param command The command
+	/// @param output Print to write the result to
+	/// @return True if the command was valid
+	static bool command(const char *command, Print &output);
+
+	/// @brief Returns true if a site matches a file, line and format selection
+	static bool matches(const JBLogSite &site, const char *file, uint16_t firstLine,
+						uint16_t lastLine, const char *format);
+
+private:
+	static JBLogSite *_first;							///< First site in the list
+
+#if JBLOGGER_MAX_SITE_RULES > 0
+	/// @brief A remembered change
+	struct Rule {
+		char file[JBLOGGER_MAX_SITE_PATTERN + 1];		///< File pattern, empty for any
+		char format[JBLOGGER_MAX_SITE_PATTERN + 1];		///< Format text, empty for any
+		uint16_t firstLine;								///< First line, 0 for any
+		uint16_t lastLine;								///< Last line
+		uint8_t mode;									///< Mode to set
+	};
+
+	static Rule _rules[JBLOGGER_MAX_SITE_RULES];		///< Remembered changes, oldest first
+	static uint8_t _ruleCount;							///< Number of remembered changes
+#endif
+};
+
+/// @brief Reads JBLogSites commands from a stream
+/// @details Call loop() from the sketch loop() function. Each line read from the stream is
+/// run with JBLogSites::command(), and the result is written back to the stream.
+///
+/// JBLogSiteConsole console(Serial);
+///
+class JBLogSiteConsole {
+public:
+	/// @brief Constructor
+	/// @param stream Stream to read commands from and write results to
+	explicit JBLogSiteConsole(Stream &stream);
+
+	/// @brief Reads the available characters, and runs a command when a line is complete
+	void loop();
+
+private:
+	Stream &_stream;									///< Command stream
+	char _command[JBLOGGER_MAX_SITE_COMMAND + 1];		///< Command being read
+	uint8_t _length = 0;								///< Length of _command
+};
+
+#endif // JBLOGGER_SITES_H
@@ -0,0 +1,278 @@
+/// @file jblogger_syslog.cpp
+/// @author Jonny Bergdahl
+/// @brief Batched UDP syslog output for JBLogger
+/// @date Created: 2026-10-18
+/// @details This file contains the code for JBSyslogStream.
+///
+/// You can find the source code and/ collaborate on
+/// [https://github.com/jonnybergdahl/Bergdahl_JBLogger](https://github.com/jonnybergdahl/Bergdahl_JBLogger).
+///
+/// This code is distributed under the MIT License. See the LICENSE file for details.
+#include "jblogger_syslog.h"
+#include <string.h>
+
+#define SYSLOG_FACILITY_LOCAL0 16			///< Facility used in the PRI
+#define SYSLOG_SEVERITY_NONE 8				///< Severity of an empty datagram, above debug (7)
+#define SYSLOG_MAX_HOST_NAME 255			///< RFC 5424 limit of HOSTNAME
+#define SYSLOG_MAX_APP_NAME 48				///< RFC 5424 limit of APP-NAME
+#define SYSLOG_MAX_HEADER (46 + SYSLOG_MAX_HOST_NAME + SYSLOG_MAX_APP_NAME)	///< Longest header
+
+static_assert(JBLOGGER_SYSLOG_DATAGRAM_SIZE >= SYSLOG_MAX_HEADER + 128,
+			  "JBLOGGER_SYSLOG_DATAGRAM_SIZE is too small");
+static_assert(JBLOGGER_SYSLOG_BACKLOG_SIZE >= JBLOGGER_SYSLOG_DATAGRAM_SIZE + 2 &&
+			  JBLOGGER_SYSLOG_BACKLOG_SIZE <= 0xffff,
+			  "JBLOGGER_SYSLOG_BACKLOG_SIZE must hold a datagram and fit in 16 bits");
+
+/// @brief Returns the length of a string, capped to a maximum
+static size_t cappedLength(const char *text, size_t max) {
+	size_t length = 0;
+	while (length < max && text[length] != '\0') {
+		length++;
+	}
+	return length;
+}
+
+/// @brief Returns the syslog severity of a log line, from the log level letter in its prefix
+static uint8_t lineSeverity(const char *line, size_t length) {
+	size_t i = 0;
+	if (length > 0 && line[0] == '(') {
+		while (i < length && line[i] != ')') {
+			i++;
+		}
+		i += 2;
+	}
+	if (i + 1 < length && line[i + 1] == ' ') {
+		switch (line[i]) {
+			case 'E': return 3;
+			case 'W': return 4;
+			case 'I': return 6;
+			case 'D': return 7;
+			case 'T': return 7;
+			default: break;
+		}
+	}
+	return 6;
+}
+
+JBSyslogStream::JBSyslogStream(UDP &udp, IPAddress host, uint16_t port,
+							   const char *hostName, const char *appName)
+		: _udp(udp), _host(host), _hostAddress(nullptr), _resolved(true), _port(port),
+		  _hostName(hostName), _appName(appName), _severity(SYSLOG_SEVERITY_NONE) {
+	_payloadCapacity = JBLOGGER_SYSLOG_DATAGRAM_SIZE - 46
+					   - cappedLength(_hostName, SYSLOG_MAX_HOST_NAME)
+					   - cappedLength(_appName, SYSLOG_MAX_APP_NAME);
+}
+
+JBSyslogStream::JBSyslogStream(UDP &udp, const char *host, uint16_t port,
+							   const char *hostName, const char *appName)
+		: JBSyslogStream(udp, IPAddress(), port, hostName, appName) {
+	_hostAddress = host;
+	_resolved = false;
+}
+
+size_t JBSyslogStream::write(uint8_t value) {
+	return write(&value, 1);
+}
+
+size_t JBSyslogStream::write(const uint8_t *buffer, size_t size) {
+	for (size_t i = 0; i < size; i++) {
+		const char c = static_cast<char>(buffer[i]);
+		if (c == '\n') {
+			_addLine();
+		} else if (_lineLength < sizeof(_line)) {
+			_line[_lineLength++] = c;
+		}
+	}
+	_update(false);
+	return size;
+}
+
+void JBSyslogStream::flush() {
+	if (_payloadLength > 0) {
+		_close();
+	}
+	_retryAt = millis();
+	_send(false);
+}
+
+void JBSyslogStream::loop() {
+	_update(true);
+}
+
+void JBSyslogStream::setResolver(JBSyslogResolver resolver) {
+	_resolver = resolver;
+	if (_hostAddress != nullptr) {
+		_resolved = false;
+	}
+}
+
+int JBSyslogStream::available() {
+	return 0;
+}
+
+int JBSyslogStream::read() {
+	return -1;
+}
+
+int JBSyslogStream::peek() {
+	return -1;
+}
+
+void JBSyslogStream::setMaxDelay(uint32_t value) {
+	_maxDelay = value;
+}
+
+uint32_t JBSyslogStream::getMaxDelay() const {
+	return _maxDelay;
+}
+
+uint32_t JBSyslogStream::getDatagramsSent() const {
+	return _sent;
+}
+
+uint32_t JBSyslogStream::getDatagramsDropped() const {
+	return _dropped;
+}
+
+uint32_t JBSyslogStream::getSequence() const {
+	return _sequence;
+}
+
+void JBSyslogStream::_addLine() {
+	size_t length = _lineLength;
+	_lineLength = 0;
+	if (length > 0 && _line[length - 1] == '\r') {
+		length--;
+	}
+	if (length == 0) {
+		return;
+	}
+	if (length > _payloadCapacity) {
+		length = _payloadCapacity;
+	}
+
+	if (_payloadLength > 0 && _payloadLength + 1 + length > _payloadCapacity) {
+		_close();
+	}
+	if (_payloadLength == 0) {
+		_openedAt = millis();
+	} else {
+		_payload[_payloadLength++] = '\n';
+	}
+	memcpy(_payload + _payloadLength, _line, length);
+	_payloadLength += length;
+
+	const uint8_t severity = lineSeverity(_line, length);
+	if (severity < _severity) {
+		_severity = severity;
+	}
+}
+
+void JBSyslogStream::_close() {
+	if (++_sequence > 2147483647UL) {
+		// RFC 5424 sequenceId range is 1 - 2147483647
+		_sequence = 1;
+	}
+
+	char header[SYSLOG_MAX_HEADER + 1];
+	const int headerLength = snprintf(header, sizeof(header), "<%u>1 - %.*s %.*s - - [meta sequenceId=\"%lu\"] ",
+									  static_cast<unsigned>(SYSLOG_FACILITY_LOCAL0 * 8 + _severity),
+									  static_cast<int>(cappedLength(_hostName, SYSLOG_MAX_HOST_NAME)), _hostName,
+									  static_cast<int>(cappedLength(_appName, SYSLOG_MAX_APP_NAME)), _appName,
+									  static_cast<unsigned long>(_sequence));
+	const uint16_t length = static_cast<uint16_t>(headerLength + _payloadLength);
+
+	// Make room by dropping the oldest datagrams
+	while (JBLOGGER_SYSLOG_BACKLOG_SIZE - _backlogUsed < length + 2) {
+		const uint16_t oldest = _backlogLength(_backlogHead) + 2;
+		_backlogHead = (_backlogHead + oldest) % JBLOGGER_SYSLOG_BACKLOG_SIZE;
+		_backlogUsed -= oldest;
+		_dropped++;
+	}
+
+	const uint8_t prefix[2] = { static_cast<uint8_t>(length & 0xff), static_cast<uint8_t>(length >> 8) };
+	uint16_t offset = (_backlogHead + _backlogUsed) % JBLOGGER_SYSLOG_BACKLOG_SIZE;
+	_backlogWrite(offset, prefix, 2);
+	offset = (offset + 2) % JBLOGGER_SYSLOG_BACKLOG_SIZE;
+	_backlogWrite(offset, header, headerLength);
+	offset = (offset + headerLength) % JBLOGGER_SYSLOG_BACKLOG_SIZE;
+	_backlogWrite(offset, _payload, _payloadLength);
+	_backlogUsed += length + 2;
+
+	_payloadLength = 0;
+	_severity = SYSLOG_SEVERITY_NONE;
+}
+
+void JBSyslogStream::_update(bool resolve) {
+	if (_payloadLength > 0 && millis() - _openedAt >= _maxDelay) {
+		_close();
+	}
+	if (_backlogUsed > 0) {
+		_send(resolve);
+	}
+}
+
+void JBSyslogStream::_send(bool resolve) {
+	while (_backlogUsed > 0) {
+		if (_retryDelay > 0 && static_cast<int32_t>(millis() - _retryAt) < 0) {
+			return;
+		}
+		if (!_resolved) {
+			// Name lookups can block, they are only done from loop()
+			if (!resolve) {
+				return;
+			}
+			if (_resolver != nullptr) {
+				_resolved = _resolver(_hostAddress, _host);
+				if (!_resolved) {
+					_backOff();
+					return;
+				}
+			}
+		}
+
+		const uint16_t length = _backlogLength(_backlogHead);
+		const uint16_t start = (_backlogHead + 2) % JBLOGGER_SYSLOG_BACKLOG_SIZE;
+		const uint16_t first = length < JBLOGGER_SYSLOG_BACKLOG_SIZE - start ? length : JBLOGGER_SYSLOG_BACKLOG_SIZE - start;
+
+		int result = _resolved ? _udp.beginPacket(_host, _port) : _udp.beginPacket(_hostAddress, _port);
+		if (result) {
+			_udp.write(_backlog + start, first);
+			if (first < length) {
+				_udp.write(_backlog, length - first);
+			}
+			result = _udp.endPacket();
+		}
+		if (!result) {
+			// Link down or host not resolved, keep the datagram and back off. The address of a
+			// host name may have changed, so it is resolved again.
+			if (_hostAddress != nullptr && _resolver != nullptr) {
+				_resolved = false;
+			}
+			_backOff();
+			return;
+		}
+
+		_retryDelay = 0;
+		_backlogHead = (_backlogHead + length + 2) % JBLOGGER_SYSLOG_BACKLOG_SIZE;
+		_backlogUsed -= length + 2;
+		_sent++;
+	}
+}
+
+void JBSyslogStream::_backOff() {
+	_retryDelay = _retryDelay == 0 ? JBLOGGER_SYSLOG_RETRY_MIN :
+				  _retryDelay * 2 > JBLOGGER_SYSLOG_RETRY_MAX ? JBLOGGER_SYSLOG_RETRY_MAX : _retryDelay * 2;
+	_retryAt = millis() + _retryDelay;
+}
+
+void JBSyslogStream::_backlogWrite(uint16_t offset, const void *data, uint16_t size) {
+	const auto *bytes = static_cast<const uint8_t *>(data);
+	const uint16_t first = size < JBLOGGER_SYSLOG_BACKLOG_SIZE - offset ? size : JBLOGGER_SYSLOG_BACKLOG_SIZE - offset;
+	memcpy(_backlog + offset, bytes, first);
+	memcpy(_backlog, bytes + first, size - first);
+}
+
+uint16_t JBSyslogStream::_backlogLength(uint16_t offset) const {
+	return static_cast<uint16_t>(_backlog[offset] | (_backlog[(offset + 1) % JBLOGGER_SYSLOG_BACKLOG_SIZE] << 8));
+}
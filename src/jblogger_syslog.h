@@ -0,0 +1,192 @@
+/// @file jblogger_syslog.h
+/// @author Jonny Bergdahl
+/// @brief Batched UDP syslog output for JBLogger
+/// @date Created: 2026-10-18
+/// @details This file contains JBSyslogStream, a network output that packs complete log
+/// lines into RFC 5424 syslog datagrams.
+///
+/// You can find the source code and/ collaborate on
+/// [https://github.com/jonnybergdahl/Bergdahl_JBLogger](https://github.com/jonnybergdahl/Bergdahl_JBLogger).
+///
+/// This code is distributed under the MIT License. See the LICENSE file for details.
+#ifndef JBLOGGER_SYSLOG_H
+#define JBLOGGER_SYSLOG_H
+
+#include <Arduino.h>
+#include <Udp.h>
+#include "jblogger.h"
+
+#ifndef JBLOGGER_SYSLOG_DATAGRAM_SIZE
+#define JBLOGGER_SYSLOG_DATAGRAM_SIZE 1400		///< Maximum datagram size, keep it below the path MTU
+#endif
+#ifndef JBLOGGER_SYSLOG_BACKLOG_SIZE
+#define JBLOGGER_SYSLOG_BACKLOG_SIZE 4096		///< Size of the backlog of datagrams not yet sent
+#endif
+#define JBLOGGER_SYSLOG_PORT 514				///< Default syslog port
+#define JBLOGGER_SYSLOG_MAX_DELAY 1000			///< Default time in ms a line may wait for more lines
+#define JBLOGGER_SYSLOG_RETRY_MIN 100			///< First retry delay in ms after a failed send
+#define JBLOGGER_SYSLOG_RETRY_MAX 5000			///< Longest retry delay in ms after failed sends
+
+/// @brief Resolves a host name to an address
+/// @param host Host name
+/// @param address Set to the address of the host
+/// @return True if the host name was resolved
+typedef bool (*JBSyslogResolver)(const char *host, IPAddress &address);
+
+/// @brief Batched UDP syslog output
+/// @details This class collects the log lines written to it and sends them as RFC 5424
+/// syslog messages over UDP, many lines in each datagram. Each datagram has a syslog header,
+/// followed by the lines separated by linefeeds:
+///
+/// <PRI>1 - hostname app-name - - [meta sequenceId="42"] first line
+///
+/// The PRI uses the local0 facility and the most severe log level found in the datagram.
+/// The sequenceId counts datagrams from 1, so the receiver can detect lost datagrams.
+///
+/// A datagram is sent when it is full, when its first line has waited for the max delay,
+/// or when flush() is called. Call loop() from the sketch loop to send lines without waiting
+/// for the next one. Datagrams are queued in a backlog of JBLOGGER_SYSLOG_BACKLOG_SIZE bytes.
+/// When a send fails, for example because WiFi is down, the datagram stays in the backlog and
+/// sending is retried later, backing off from JBLOGGER_SYSLOG_RETRY_MIN to
+/// JBLOGGER_SYSLOG_RETRY_MAX ms. Writing never waits for the network. When the backlog is
+/// full the oldest datagrams are dropped.
+///
+/// A host name is resolved from loop() only, never while logging, as the lookup can block
+/// for seconds. The address is kept until a send fails, and then resolved again from loop().
+/// Set a resolver using setResolver(), the library does not depend on a WiFi library. On
+/// ESP8266 and ESP32 the sketch can use WiFi.hostByName():
+///
+/// syslog.setResolver([](const char *host, IPAddress &address) { return WiFi.hostByName(host, address) == 1; });
+///
+/// Without a resolver the host name is given to the UDP instance, and datagrams are only
+/// sent from loop().
+///
+/// JBSyslogStream syslog(udp, IPAddress(192, 168, 1, 10), JBLOGGER_SYSLOG_PORT, "sensor-1", "app");
+/// JBLogger logger("NET", LOG_LEVEL_INFO, syslog);
+///
+class JBSyslogStream final : public Stream {
+public:
+	/// @brief Constructor
+	/// @param udp UDP instance used for sending, for example a WiFiUDP
+	/// @param host Address of the syslog server
+	/// @param port Port of the syslog server, defaults to 514
+	/// @param hostName Host name in the syslog header, defaults to "-"
+	/// @param appName Application name in the syslog header, defaults to "-"
+	///
+	JBSyslogStream(UDP &udp, IPAddress host, uint16_t port = JBLOGGER_SYSLOG_PORT,
+				   const char *hostName = "-", const char *appName = "-");
+
+	/// @brief Constructor
+	/// @param udp UDP instance used for sending, for example a WiFiUDP
+	/// @param host Host name of the syslog server, resolved from loop()
+	/// @param port Port of the syslog server, defaults to 514
+	/// @param hostName Host name in the syslog header, defaults to "-"
+	/// @param appName Application name in the syslog header, defaults to "-"
+	///
+	JBSyslogStream(UDP &udp, const char *host, uint16_t port = JBLOGGER_SYSLOG_PORT,
+				   const char *hostName = "-", const char *appName = "-");
+
+	/// @brief Adds a byte to the current line
+	/// @param value Byte to add
+	/// @return 1
+	size_t write(uint8_t value) override;
+
+	/// @brief Adds a buffer to the current line, each linefeed completes a line
+	/// @param buffer Data to add
+	/// @param size Number of bytes
+	/// @return size
+	size_t write(const uint8_t *buffer, size_t size) override;
+
+	using Print::write;
+
+	/// @brief Sends the collected lines without waiting for more, a partial line is kept
+	void flush() override;
+
+	/// @brief Sends lines that have waited for the max delay, and retries failed sends
+	///
+	/// Call this from the sketch loop() function. This is also where the host name is
+	/// resolved, so it may block while the name is looked up.
+	///
+	void loop();
+
+	/// @brief Sets the function used to resolve the host name
+	/// @param resolver Resolver, or nullptr to give the host name to the UDP instance
+	void setResolver(JBSyslogResolver resolver);
+
+	/// @brief Always returns 0, the stream is write only
+	int available() override;
+
+	/// @brief Always returns -1, the stream is write only
+	int read() override;
+
+	/// @brief Always returns -1, the stream is write only
+	int peek() override;
+
+	/// @brief Sets how long a line may wait for more lines before it is sent
+	/// @param value Max delay in ms
+	void setMaxDelay(uint32_t value);
+
+	/// @brief Returns how long a line may wait for more lines before it is sent
+	/// @return Max delay in ms
+	uint32_t getMaxDelay() const;
+
+	/// @brief Returns the number of datagrams sent
+	uint32_t getDatagramsSent() const;
+
+	/// @brief Returns the number of datagrams dropped because the backlog was full
+	uint32_t getDatagramsDropped() const;
+
+	/// @brief Returns the sequence number of the last datagram created
+	uint32_t getSequence() const;
+
+private:
+	UDP &_udp;												///< UDP instance used for sending
+	IPAddress _host;										///< Address of the syslog server
+	const char *_hostAddress;								///< Host name of the syslog server, or nullptr
+	JBSyslogResolver _resolver = nullptr;					///< Resolver of _hostAddress
+	bool _resolved;											///< True if _host holds the address to send to
+	uint16_t _port;											///< Port of the syslog server
+	const char *_hostName;									///< Host name in the syslog header
+	const char *_appName;									///< Application name in the syslog header
+	char _line[MAX_LINE_LENGTH];							///< Line being written
+	uint16_t _lineLength = 0;								///< Length of _line
+	char _payload[JBLOGGER_SYSLOG_DATAGRAM_SIZE];			///< Lines of the open datagram
+	uint16_t _payloadLength = 0;							///< Length of _payload
+	uint16_t _payloadCapacity;								///< Room for lines, after the header
+	uint8_t _severity;										///< Most severe syslog severity in _payload
+	uint32_t _openedAt = 0;									///< millis() when the first line was added
+	uint32_t _maxDelay = JBLOGGER_SYSLOG_MAX_DELAY;			///< Max delay in ms
+	uint8_t _backlog[JBLOGGER_SYSLOG_BACKLOG_SIZE];			///< Queued datagrams, length prefixed
+	uint16_t _backlogHead = 0;								///< Offset of the oldest datagram
+	uint16_t _backlogUsed = 0;								///< Bytes used in _backlog
+	uint32_t _retryAt = 0;									///< millis() of the next send attempt
+	uint16_t _retryDelay = 0;								///< Current retry delay, 0 when sending works
+	uint32_t _sequence = 0;									///< Sequence number of the last datagram
+	uint32_t _sent = 0;										///< Datagrams sent
+	uint32_t _dropped = 0;									///< Datagrams dropped
+
+	/// @brief Adds the current line to the open datagram
+	void _addLine();
+
+	/// @brief Moves the open datagram to the backlog, adding the syslog header
+	void _close();
+
+	/// @brief Closes a datagram that has waited for the max delay, and sends the backlog
+	/// @param resolve True if the host name may be resolved, only when called from loop()
+	void _update(bool resolve);
+
+	/// @brief Sends datagrams from the backlog until it is empty or a send fails
+	/// @param resolve True if the host name may be resolved, only when called from loop()
+	void _send(bool resolve);
+
+	/// @brief Delays the next send attempt after a failure
+	void _backOff();
+
+	/// @brief Copies bytes into the backlog ring at an offset
+	void _backlogWrite(uint16_t offset, const void *data, uint16_t size);
+
+	/// @brief Reads the length prefix of the datagram at an offset in the backlog ring
+	uint16_t _backlogLength(uint16_t offset) const;
+};
+
+#endif // JBLOGGER_SYSLOG_H